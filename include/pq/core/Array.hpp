@@ -0,0 +1,248 @@
+#pragma once
+
+/**
+ * @file Array.hpp
+ * @brief PostgreSQL array support for std::vector<T>
+ *
+ * Any element type whose PgTypeTraits declare pgArrayOid can be used as a
+ * one-dimensional array, so a whole batch travels as a single parameter:
+ *
+ * @code
+ * std::vector<int64_t> ids = {1, 2, 3};
+ * conn.executeParams("SELECT * FROM users WHERE id = ANY($1)", ids);
+ * @endcode
+ *
+ * Use std::vector<std::optional<T>> for arrays that may contain NULLs.
+ */
+
+#include "Types.hpp"
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace pq {
+
+/**
+ * @brief Detect element types that have a PostgreSQL array type
+ */
+template<typename T, typename = void>
+struct HasArrayType : std::false_type {};
+
+template<typename T>
+struct HasArrayType<T, std::void_t<decltype(PgTypeTraits<OptionalInnerT<T>>::pgArrayOid)>>
+    : std::true_type {};
+
+template<typename T>
+inline constexpr bool hasArrayTypeV = HasArrayType<T>::value;
+
+/**
+ * @brief Detect whether PgTypeTraits<T> provides a binary encoder
+ */
+template<typename T, typename = void>
+struct HasBinaryEncoder : std::false_type {};
+
+template<typename T>
+struct HasBinaryEncoder<T, std::void_t<decltype(
+    PgTypeTraits<T>::toBinary(std::declval<const T&>()))>> : std::true_type {};
+
+template<typename T>
+inline constexpr bool hasBinaryEncoderV = HasBinaryEncoder<T>::value;
+
+namespace detail {
+
+/**
+ * @brief Append one element to array text, quoting it when required
+ */
+void appendArrayElement(std::string& out, std::string_view value);
+
+/**
+ * @brief Tokenizer for the one-dimensional array text format ({a,"b",NULL})
+ *
+ * Element text is unescaped into a caller-provided buffer that is reused
+ * across elements.
+ */
+class ArrayTextParser {
+    const char* pos_;
+    const char* text_;
+    bool done_ = false;
+
+public:
+    /**
+     * @throws std::invalid_argument if the text is not a one-dimensional array
+     */
+    explicit ArrayTextParser(const char* text);
+    
+    /**
+     * @brief Read the next element
+     * @param element Receives the unescaped element text
+     * @param isNull Set when the element is an unquoted NULL
+     * @return false after the last element
+     * @throws std::invalid_argument on malformed input
+     */
+    bool next(std::string& element, bool& isNull);
+
+private:
+    [[noreturn]] void fail(const char* reason) const;
+};
+
+/**
+ * @brief Reader for the binary array wire format
+ *
+ * Layout: ndim, has-null flag, element OID, (size, lower bound) per
+ * dimension, then a length-prefixed value per element (-1 for NULL).
+ */
+class ArrayBinaryReader {
+    const char* pos_;
+    const char* end_;
+    int32_t count_ = 0;
+
+public:
+    /**
+     * @throws std::runtime_error on malformed or multidimensional input
+     */
+    ArrayBinaryReader(const char* data, int length);
+    
+    [[nodiscard]] int32_t size() const noexcept { return count_; }
+    
+    /**
+     * @brief Read the next element
+     * @param data Receives the element bytes, or nullptr for NULL
+     * @param length Receives the element length in bytes
+     * @throws std::runtime_error if the element overruns the buffer
+     */
+    void next(const char*& data, int& length);
+};
+
+/**
+ * @brief Write the binary array header for a one-dimensional array
+ */
+void appendBinaryArrayHeader(std::string& out, Oid elementOid,
+                             std::size_t count, bool hasNull);
+
+/**
+ * @brief Throw for a NULL element in an array of a non-optional type
+ */
+[[noreturn]] void throwNullArrayElement(const char* typeName);
+
+} // namespace detail
+
+/**
+ * @brief Type traits for std::vector<T> (one-dimensional arrays)
+ */
+template<typename T>
+struct PgTypeTraits<std::vector<T>, std::enable_if_t<hasArrayTypeV<T>>> {
+    using Element = OptionalInnerT<T>;
+    using ElementTraits = PgTypeTraits<Element>;
+    
+    static constexpr Oid pgOid = ElementTraits::pgArrayOid;
+    static constexpr const char* pgTypeName = ElementTraits::pgArrayTypeName;
+    static constexpr bool isNullable = false;
+    static constexpr Oid elementOid = ElementTraits::pgOid;
+    
+    [[nodiscard]] static std::string toString(const std::vector<T>& values) {
+        std::string out;
+        out.reserve(2 + values.size() * 8);
+        out.push_back('{');
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            if (i > 0) {
+                out.push_back(',');
+            }
+            if constexpr (isOptionalV<T>) {
+                if (!values[i]) {
+                    out.append("NULL");
+                    continue;
+                }
+                appendTextElement(out, *values[i]);
+            } else {
+                appendTextElement(out, values[i]);
+            }
+        }
+        out.push_back('}');
+        return out;
+    }
+    
+    [[nodiscard]] static std::vector<T> fromString(const char* str) {
+        std::vector<T> values;
+        detail::ArrayTextParser parser(str);
+        std::string element;
+        bool isNull = false;
+        while (parser.next(element, isNull)) {
+            if (isNull) {
+                if constexpr (isOptionalV<T>) {
+                    values.emplace_back(std::nullopt);
+                    continue;
+                } else {
+                    detail::throwNullArrayElement(pgTypeName);
+                }
+            }
+            values.emplace_back(ElementTraits::fromString(element.c_str()));
+        }
+        return values;
+    }
+    
+    template<typename E = Element, typename = std::enable_if_t<hasBinaryDecoderV<E>>>
+    [[nodiscard]] static std::vector<T> fromBinary(const char* data, int length) {
+        detail::ArrayBinaryReader reader(data, length);
+        std::vector<T> values;
+        values.reserve(static_cast<std::size_t>(reader.size()));
+        for (int32_t i = 0; i < reader.size(); ++i) {
+            const char* value = nullptr;
+            int valueLength = 0;
+            reader.next(value, valueLength);
+            if (!value) {
+                if constexpr (isOptionalV<T>) {
+                    values.emplace_back(std::nullopt);
+                    continue;
+                } else {
+                    detail::throwNullArrayElement(pgTypeName);
+                }
+            }
+            values.emplace_back(ElementTraits::fromBinary(value, valueLength));
+        }
+        return values;
+    }
+    
+    template<typename E = Element, typename = std::enable_if_t<hasBinaryEncoderV<E>>>
+    [[nodiscard]] static std::string toBinary(const std::vector<T>& values) {
+        bool hasNull = false;
+        if constexpr (isOptionalV<T>) {
+            for (const auto& v : values) {
+                hasNull = hasNull || !v;
+            }
+        }
+        
+        std::string out;
+        detail::appendBinaryArrayHeader(out, elementOid, values.size(), hasNull);
+        for (const auto& v : values) {
+            if constexpr (isOptionalV<T>) {
+                if (!v) {
+                    detail::appendBE32(out, 0xFFFFFFFFu);
+                    continue;
+                }
+                appendBinaryElement(out, *v);
+            } else {
+                appendBinaryElement(out, v);
+            }
+        }
+        return out;
+    }
+
+private:
+    static void appendTextElement(std::string& out, const Element& value) {
+        if constexpr (hasFormatToV<Element>) {
+            char buf[ElementTraits::maxTextLength];
+            const std::size_t n = ElementTraits::formatTo(value, buf, sizeof(buf));
+            detail::appendArrayElement(out, std::string_view(buf, n));
+        } else {
+            detail::appendArrayElement(out, ElementTraits::toString(value));
+        }
+    }
+    
+    static void appendBinaryElement(std::string& out, const Element& value) {
+        const auto& bytes = ElementTraits::toBinary(value);
+        detail::appendBE32(out, static_cast<uint32_t>(bytes.size()));
+        out.append(bytes);
+    }
+};
+
+} // namespace pq
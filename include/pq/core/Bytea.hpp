@@ -0,0 +1,163 @@
+#pragma once
+
+/**
+ * @file Bytea.hpp
+ * @brief bytea support for binary payloads
+ *
+ * std::vector<std::byte> owns its bytes; pq::BytesView borrows them. Both are
+ * sent as binary parameters, so payloads are not hex-encoded on the wire.
+ */
+
+#include "Types.hpp"
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace pq {
+
+/**
+ * @brief Non-owning view over a contiguous byte range
+ *
+ * Usage:
+ * @code
+ * std::vector<std::byte> blob = loadFile();
+ * conn.executeParams("INSERT INTO files (data) VALUES ($1)", pq::BytesView(blob));
+ *
+ * // Zero-copy read from a binary result; valid while the result lives
+ * auto result = conn.executeBinary("SELECT data FROM files WHERE id = $1", id);
+ * pq::BytesView data = result->at(0).get<pq::BytesView>(0);
+ * @endcode
+ */
+class BytesView {
+    const std::byte* data_ = nullptr;
+    std::size_t size_ = 0;
+
+public:
+    constexpr BytesView() noexcept = default;
+    
+    constexpr BytesView(const std::byte* data, std::size_t size) noexcept
+        : data_(data)
+        , size_(size) {}
+    
+    BytesView(const void* data, std::size_t size) noexcept
+        : data_(static_cast<const std::byte*>(data))
+        , size_(size) {}
+    
+    BytesView(const std::vector<std::byte>& bytes) noexcept
+        : data_(bytes.data())
+        , size_(bytes.size()) {}
+    
+    [[nodiscard]] constexpr const std::byte* data() const noexcept { return data_; }
+    [[nodiscard]] constexpr std::size_t size() const noexcept { return size_; }
+    [[nodiscard]] constexpr bool empty() const noexcept { return size_ == 0; }
+    
+    [[nodiscard]] constexpr const std::byte* begin() const noexcept { return data_; }
+    [[nodiscard]] constexpr const std::byte* end() const noexcept { return data_ + size_; }
+    
+    [[nodiscard]] constexpr std::byte operator[](std::size_t i) const noexcept {
+        return data_[i];
+    }
+    
+    /**
+     * @brief Copy the bytes into an owning vector
+     */
+    [[nodiscard]] std::vector<std::byte> toVector() const {
+        return std::vector<std::byte>(begin(), end());
+    }
+    
+    /**
+     * @brief View the bytes as characters (for libpq and std::string APIs)
+     */
+    [[nodiscard]] std::string_view asChars() const noexcept {
+        return std::string_view(reinterpret_cast<const char*>(data_), size_);
+    }
+};
+
+namespace detail {
+
+/**
+ * @brief Format bytes as bytea hex text (\x0a1b...)
+ */
+[[nodiscard]] std::string encodeByteaText(BytesView bytes);
+
+/**
+ * @brief Parse bytea text output, hex (\x...) or legacy escape format
+ * @throws std::invalid_argument on malformed input
+ */
+[[nodiscard]] std::vector<std::byte> decodeByteaText(const char* str);
+
+} // namespace detail
+
+/**
+ * @brief Type traits for std::vector<std::byte> (bytea)
+ */
+template<>
+struct PgTypeTraits<std::vector<std::byte>> {
+    static constexpr Oid pgOid = oid::BYTEA;
+    static constexpr const char* pgTypeName = "bytea";
+    static constexpr bool isNullable = false;
+    static constexpr Oid pgArrayOid = oid::BYTEA_ARRAY;
+    static constexpr const char* pgArrayTypeName = "bytea[]";
+    static constexpr Format paramFormat = Format::Binary;
+    
+    [[nodiscard]] static std::string toString(const std::vector<std::byte>& value) {
+        return detail::encodeByteaText(value);
+    }
+    
+    [[nodiscard]] static std::vector<std::byte> fromString(const char* str) {
+        return detail::decodeByteaText(str);
+    }
+    
+    [[nodiscard]] static std::vector<std::byte> fromBinary(const char* data, int length) {
+        const auto* bytes = reinterpret_cast<const std::byte*>(data);
+        return std::vector<std::byte>(bytes, bytes + length);
+    }
+    
+    [[nodiscard]] static std::string toBinary(const std::vector<std::byte>& value) {
+        return std::string(BytesView(value).asChars());
+    }
+    
+    [[nodiscard]] static std::string_view toBinaryView(const std::vector<std::byte>& value) {
+        return BytesView(value).asChars();
+    }
+};
+
+/**
+ * @brief Type traits for pq::BytesView (bytea, non-owning)
+ *
+ * Reading is only possible from binary-format results, where the view
+ * points into the result buffer; text results need decoding into
+ * std::vector<std::byte>.
+ */
+template<>
+struct PgTypeTraits<BytesView> {
+    static constexpr Oid pgOid = oid::BYTEA;
+    static constexpr const char* pgTypeName = "bytea";
+    static constexpr bool isNullable = false;
+    static constexpr Format paramFormat = Format::Binary;
+    
+    [[nodiscard]] static std::string toString(BytesView value) {
+        return detail::encodeByteaText(value);
+    }
+    
+    [[noreturn]] static BytesView fromString(const char*) {
+        throw std::runtime_error(
+            "BytesView requires a binary-format result; "
+            "read text results as std::vector<std::byte>");
+    }
+    
+    [[nodiscard]] static BytesView fromBinary(const char* data, int length) {
+        return BytesView(data, static_cast<std::size_t>(length));
+    }
+    
+    [[nodiscard]] static std::string toBinary(BytesView value) {
+        return std::string(value.asChars());
+    }
+    
+    [[nodiscard]] static std::string_view toBinaryView(BytesView value) {
+        return value.asChars();
+    }
+};
+
+} // namespace pq
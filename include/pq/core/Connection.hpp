@@ -12,17 +12,25 @@
 #include "Result.hpp"
 #include "QueryResult.hpp"
 #include "Types.hpp"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
 #include <string>
 #include <string_view>
 #include <vector>
 #include <initializer_list>
 #include <memory>
+#include <tuple>
+#include <unordered_set>
 
 namespace pq {
 namespace core {
 
 // Forward declarations
 class Transaction;
+class Savepoint;
+class RowStream;
 
 /**
  * @brief Configuration options for a database connection
@@ -47,6 +55,15 @@ struct ConnectionConfig {
     [[nodiscard]] static ConnectionConfig fromConnectionString(std::string_view connStr);
 };
 
+/**
+ * @brief Message delivered by NOTIFY / pg_notify() to a LISTENing connection
+ */
+struct Notification {
+    std::string channel;
+    std::string payload;
+    int backendPid = 0;  // Server process that sent it
+};
+
 /**
  * @brief RAII wrapper for PostgreSQL database connection
  * 
@@ -56,8 +73,13 @@ struct ConnectionConfig {
 class Connection {
     PgConnPtr conn_;
     bool inTransaction_{false};
+    std::unordered_set<std::string> prepared_;  // Statements prepared on this session
+    uint64_t rollbacks_{0};  // Rollbacks seen so far, including to savepoints
+    std::vector<std::function<void()>> afterCommit_;  // Run when the open transaction commits
     
     friend class Transaction;
+    friend class Savepoint;
+    friend class RowStream;
     
 public:
     /**
@@ -141,9 +163,12 @@ public:
     
     /**
      * @brief Execute a parameterized query with vector parameters
+     * @param resultFormat Requested format of the result columns
+     *        (Format::Binary decodes through PgTypeTraits<T>::fromBinary)
      */
     DbResult<QueryResult> execute(std::string_view sql,
-                                   const std::vector<std::string>& params);
+                                   const std::vector<std::string>& params,
+                                   Format resultFormat = Format::Text);
     
     /**
      * @brief Execute a parameterized query with typed parameters
@@ -154,6 +179,15 @@ public:
     template<typename... Args>
     DbResult<QueryResult> executeParams(std::string_view sql, Args&&... args);
     
+    /**
+     * @brief Execute a parameterized query requesting binary-format results
+     * 
+     * Values are decoded with PgTypeTraits<T>::fromBinary(), which skips text
+     * parsing and allows zero-copy reads such as Row::get<BytesView>().
+     */
+    template<typename... Args>
+    DbResult<QueryResult> executeBinary(std::string_view sql, Args&&... args);
+    
     /**
      * @brief Execute a query and return affected row count
      * @param sql SQL query (INSERT/UPDATE/DELETE)
@@ -183,6 +217,72 @@ public:
     DbResult<QueryResult> executePrepared(std::string_view name,
                                            std::initializer_list<std::string> params);
     
+    /**
+     * @brief Execute a prepared statement with vector parameters
+     * 
+     * Empty strings are sent as NULL, as in execute().
+     */
+    DbResult<QueryResult> executePrepared(std::string_view name,
+                                           const std::vector<std::string>& params,
+                                           Format resultFormat = Format::Text);
+    
+    /**
+     * @brief Execute a named statement, preparing it on first use
+     * 
+     * Names are tracked per connection, so a connection handed out by a pool
+     * prepares each statement once, whoever runs it. If the server no longer
+     * knows the statement (e.g. after DISCARD ALL), it is prepared again -
+     * outside a transaction only, since the failure has already aborted an
+     * open one; there the error is returned.
+     * 
+     * @param name Statement name; the same name must always carry the same SQL
+     * @param sql SQL with $1, $2, ... placeholders
+     * @param params Parameter values (empty string = NULL)
+     */
+    DbResult<QueryResult> executeStatement(std::string_view name, std::string_view sql,
+                                            const std::vector<std::string>& params,
+                                            Format resultFormat = Format::Text);
+    
+    /**
+     * @brief Check if a statement was prepared on this connection
+     */
+    [[nodiscard]] bool isPrepared(std::string_view name) const {
+        return prepared_.count(std::string(name)) != 0;
+    }
+    
+    /**
+     * @brief Run COPY ... FROM STDIN with data in COPY text format
+     * 
+     * @param sql COPY statement, e.g. "COPY t (a, b) FROM STDIN"
+     * @param data Tab-separated, newline-terminated rows (see detail::appendCopyField)
+     * @return Number of rows copied, or error
+     */
+    DbResult<int> copyIn(std::string_view sql, std::string_view data);
+    
+    /**
+     * @brief Subscribe to a NOTIFY channel
+     * @param channel Channel name (quoted, so it is case-sensitive)
+     */
+    DbResult<void> listen(std::string_view channel);
+    
+    /**
+     * @brief Unsubscribe from a NOTIFY channel
+     */
+    DbResult<void> unlisten(std::string_view channel);
+    
+    /**
+     * @brief Collect the notifications received so far
+     * 
+     * Notifications arrive between queries and are only delivered to a
+     * connection that reads from its socket, so a listener should use a
+     * connection of its own and call this in a loop.
+     * 
+     * @param timeout How long to wait on the socket if none are pending yet
+     * @return Notifications in the order they were sent (possibly none), or error
+     */
+    DbResult<std::vector<Notification>> notifications(
+        std::chrono::milliseconds timeout = std::chrono::milliseconds(0));
+    
     /**
      * @brief Begin a transaction
      * @return Result indicating success or error
@@ -206,6 +306,28 @@ public:
         return inTransaction_;
     }
     
+    /**
+     * @brief Number of rollbacks on this connection so far
+     * 
+     * Counts rollback(), savepoint rollbacks and every COMMIT that did not
+     * commit: one that failed, or that the server turned into a ROLLBACK.
+     * Caches of rows read or written in a transaction compare it to tell
+     * when their contents may have been undone.
+     */
+    [[nodiscard]] uint64_t rollbackCount() const noexcept {
+        return rollbacks_;
+    }
+    
+    /**
+     * @brief Run fn once the open transaction has committed
+     * 
+     * Outside a transaction fn runs at once. Callbacks of a transaction that
+     * rolls back, or whose COMMIT fails, are dropped. Caches shared with
+     * other connections use it to invalidate rows when the writes become
+     * visible there.
+     */
+    void afterCommit(std::function<void()> fn);
+    
     /**
      * @brief Escape a string value for use in SQL
      * @param value String to escape
@@ -228,6 +350,10 @@ public:
     }
     
 private:
+    template<typename... Args>
+    DbResult<QueryResult> executeTyped(std::string_view sql, Format resultFormat,
+                                       Args&&... args);
+    
     /**
      * @brief Create DbError from current connection state
      */
@@ -243,45 +369,51 @@ private:
 // Template implementation
 template<typename... Args>
 DbResult<QueryResult> Connection::executeParams(std::string_view sql, Args&&... args) {
+    return executeTyped(sql, Format::Text, std::forward<Args>(args)...);
+}
+
+template<typename... Args>
+DbResult<QueryResult> Connection::executeBinary(std::string_view sql, Args&&... args) {
+    return executeTyped(sql, Format::Binary, std::forward<Args>(args)...);
+}
+
+template<typename... Args>
+DbResult<QueryResult> Connection::executeTyped(std::string_view sql, Format resultFormat,
+                                               Args&&... args) {
     if (!isConnected()) {
         return DbResult<QueryResult>::error(DbError{"Not connected"});
     }
     
-    // Convert all parameters to strings and store them
-    std::vector<std::string> paramStrings;
-    std::vector<bool> paramNulls;
-    paramStrings.reserve(sizeof...(Args));
-    paramNulls.reserve(sizeof...(Args));
-    
-    // Use fold expression to convert each argument
-    (void)std::initializer_list<int>{(
-        [&](auto&& arg) {
-            using ArgType = std::decay_t<decltype(arg)>;
-            ParamConverter<ArgType> conv(std::forward<decltype(arg)>(arg));
-            paramStrings.push_back(std::move(conv.value));
-            paramNulls.push_back(conv.isNull);
-        }(std::forward<Args>(args)), 0
-    )...};
-    
-    // Build parameter arrays for PQexecParams
-    std::vector<const char*> paramValues;
-    paramValues.reserve(sizeof...(Args));
-    
-    for (size_t i = 0; i < paramStrings.size(); ++i) {
-        paramValues.push_back(paramNulls[i] ? nullptr : paramStrings[i].c_str());
-    }
+    // The converters stay alive for the call: numbers are formatted into
+    // their inline buffers and binary values point at the arguments, so
+    // the parameter arrays live on the stack.
+    constexpr std::size_t count = sizeof...(Args);
+    std::tuple<ParamConverter<std::decay_t<Args>>...> converters(args...);
+    std::array<const char*, count> paramValues{};
+    std::array<int, count> paramLengths{};
+    std::array<int, count> paramFormats{};
+    std::array<Oid, count> paramTypes{};
+    
+    std::apply([&](const auto&... conv) {
+        [[maybe_unused]] std::size_t i = 0;
+        ((paramValues[i] = conv.isNull ? nullptr : conv.ptr,
+          paramLengths[i] = conv.length,
+          paramFormats[i] = static_cast<int>(conv.format),
+          paramTypes[i] = conv.type,
+          ++i), ...);
+    }, converters);
     
     NullTerminatedString sqlStr(sql);
     
     PgResultPtr result(PQexecParams(
         conn_.get(),
         sqlStr.c_str(),
-        static_cast<int>(paramValues.size()),
-        nullptr,  // Let PostgreSQL infer types
+        static_cast<int>(count),
+        paramTypes.data(),
         paramValues.data(),
-        nullptr,  // Text format
-        nullptr,  // Text format
-        0         // Text format result
+        paramLengths.data(),
+        paramFormats.data(),
+        static_cast<int>(resultFormat)
     ));
     
     QueryResult qr(std::move(result));
@@ -294,4 +426,14 @@ DbResult<QueryResult> Connection::executeParams(std::string_view sql, Args&&...
 }
 
 } // namespace core
+
+namespace detail {
+
+/**
+ * @brief Append one field in COPY text format, escaping backslash, tab,
+ *        newline and carriage return (NULL is written as \N by the caller)
+ */
+void appendCopyField(std::string& out, std::string_view value);
+
+} // namespace detail
 } // namespace pq
@@ -11,6 +11,7 @@
 #include "PqHandle.hpp"
 #include "Connection.hpp"
 #include "Result.hpp"
+#include "TypeRegistry.hpp"
 #include <vector>
 #include <memory>
 #include <mutex>
@@ -31,6 +32,7 @@ struct PoolConfig {
     std::chrono::milliseconds acquireTimeout{5000};  // Timeout for acquire
     std::chrono::milliseconds idleTimeout{60000};    // Idle timeout before validation
     bool validateOnAcquire = true;                // Validate connection before returning
+    std::vector<std::string> typeNames;           // Types to resolve into types() on connect
 };
 
 // Forward declaration
@@ -102,6 +104,8 @@ class ConnectionPool {
     
     bool shutdown_{false};
     
+    TypeRegistry types_;
+    
     friend class PooledConnection;
     
 public:
@@ -140,6 +144,16 @@ public:
     [[nodiscard]] size_t totalCount() const noexcept;
     [[nodiscard]] size_t maxSize() const noexcept { return config_.maxSize; }
     
+    /**
+     * @brief OIDs of database-defined types, shared by all connections
+     * 
+     * Every connection of a pool talks to the same database, so OIDs are
+     * resolved once per pool. Names in PoolConfig::typeNames are loaded when
+     * a connection is opened; others can be loaded with types().load().
+     */
+    [[nodiscard]] TypeRegistry& types() noexcept { return types_; }
+    [[nodiscard]] const TypeRegistry& types() const noexcept { return types_; }
+    
     /**
      * @brief Close all idle connections
      */
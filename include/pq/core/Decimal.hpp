@@ -0,0 +1,246 @@
+#pragma once
+
+/**
+ * @file Decimal.hpp
+ * @brief Exact decimal type for PostgreSQL NUMERIC columns
+ *
+ * Values are stored as a scaled integer (coefficient * 10^-scale) in a
+ * 128-bit register and transparently promoted to an arbitrary-precision
+ * representation when a value no longer fits, so arithmetic is always exact.
+ */
+
+#include "Types.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace pq {
+
+namespace detail {
+
+#if defined(__SIZEOF_INT128__)
+__extension__ typedef __int128 DecimalCoefficient;
+inline constexpr int decimalCompactDigits = 36;
+#else
+typedef int64_t DecimalCoefficient;
+inline constexpr int decimalCompactDigits = 17;
+#endif
+
+[[nodiscard]] constexpr DecimalCoefficient decimalPow10(int n) noexcept {
+    DecimalCoefficient result = 1;
+    while (n-- > 0) {
+        result *= 10;
+    }
+    return result;
+}
+
+// Exclusive bound of a compact coefficient; the sum of two compact values
+// never overflows DecimalCoefficient
+inline constexpr DecimalCoefficient decimalCompactLimit =
+    decimalPow10(decimalCompactDigits);
+
+} // namespace detail
+
+/**
+ * @brief Exact fixed-point decimal mirroring PostgreSQL NUMERIC
+ *
+ * Supports NaN and +/-Infinity like PostgreSQL 14+. Addition, subtraction
+ * and multiplication are exact; values outside the compact range fall back
+ * to base-1e9 arbitrary precision.
+ *
+ * Usage:
+ * @code
+ * pq::Decimal total;
+ * for (const auto& row : *result) {
+ *     total += row.get<pq::Decimal>("amount");
+ * }
+ * std::string text = total.toString();  // "12345.67"
+ * @endcode
+ */
+class Decimal {
+public:
+    enum class Kind : uint8_t {
+        Finite,
+        NaN,
+        PositiveInfinity,
+        NegativeInfinity,
+    };
+    
+    using Coefficient = detail::DecimalCoefficient;
+    using Limbs = std::vector<uint32_t>;  // Base 1e9, least significant first
+
+private:
+    Coefficient coef_{0};                // Signed coefficient (compact form)
+    int32_t scale_{0};                   // Digits after the decimal point
+    Kind kind_{Kind::Finite};
+    bool negative_{false};               // Sign of big_ (wide form only)
+    std::shared_ptr<const Limbs> big_;   // Magnitude when not compact
+
+public:
+    /**
+     * @brief Construct zero
+     */
+    Decimal() noexcept = default;
+    
+    /**
+     * @brief Construct from an integer
+     */
+    Decimal(int64_t value)
+        : coef_(value) {
+        if (coef_ >= detail::decimalCompactLimit || coef_ <= -detail::decimalCompactLimit) {
+            *this = fromScaled(value, 0);  // Only reachable without 128-bit support
+        }
+    }
+    
+    /**
+     * @brief Construct from an unscaled value, e.g. fromScaled(1234, 2) == 12.34
+     */
+    [[nodiscard]] static Decimal fromScaled(int64_t unscaled, int32_t scale);
+    
+    /**
+     * @brief Parse decimal text ("-12.340", "1e-5", "NaN", "Infinity")
+     * @throws std::invalid_argument on malformed input
+     */
+    [[nodiscard]] static Decimal fromString(std::string_view text);
+    
+    /**
+     * @brief Decode the binary NUMERIC wire format (base-10000 digits)
+     * @throws std::runtime_error on malformed input
+     */
+    [[nodiscard]] static Decimal fromBinary(const char* data, int length);
+    
+    [[nodiscard]] static Decimal nan() noexcept;
+    [[nodiscard]] static Decimal infinity(bool negative = false) noexcept;
+    
+    /**
+     * @brief Format as PostgreSQL NUMERIC text, keeping the scale
+     */
+    [[nodiscard]] std::string toString() const;
+    
+    /**
+     * @brief Convert to the nearest double
+     */
+    [[nodiscard]] double toDouble() const;
+    
+    [[nodiscard]] Kind kind() const noexcept { return kind_; }
+    [[nodiscard]] bool isFinite() const noexcept { return kind_ == Kind::Finite; }
+    [[nodiscard]] bool isNaN() const noexcept { return kind_ == Kind::NaN; }
+    [[nodiscard]] bool isInfinite() const noexcept {
+        return kind_ == Kind::PositiveInfinity || kind_ == Kind::NegativeInfinity;
+    }
+    
+    /**
+     * @brief Check if the value is held in the 128-bit compact form
+     */
+    [[nodiscard]] bool isCompact() const noexcept {
+        return kind_ == Kind::Finite && !big_;
+    }
+    
+    [[nodiscard]] bool isZero() const noexcept {
+        return isCompact() && coef_ == 0;
+    }
+    
+    [[nodiscard]] bool isNegative() const noexcept {
+        if (kind_ == Kind::NegativeInfinity) return true;
+        if (kind_ != Kind::Finite) return false;
+        return big_ ? negative_ : coef_ < 0;
+    }
+    
+    /**
+     * @brief Number of digits after the decimal point
+     */
+    [[nodiscard]] int32_t scale() const noexcept { return scale_; }
+    
+    /**
+     * @brief Change the scale, rounding half away from zero like PostgreSQL
+     */
+    [[nodiscard]] Decimal rescale(int32_t newScale) const;
+    
+    /**
+     * @brief Three-way comparison with PostgreSQL semantics
+     *
+     * Values compare numerically regardless of scale (1.10 == 1.1);
+     * NaN equals NaN and sorts above every other value.
+     * @return Negative, zero or positive
+     */
+    [[nodiscard]] int compare(const Decimal& other) const;
+    
+    [[nodiscard]] Decimal operator-() const;
+    
+    Decimal& operator+=(const Decimal& rhs);
+    Decimal& operator-=(const Decimal& rhs);
+    Decimal& operator*=(const Decimal& rhs);
+    
+    friend Decimal operator+(Decimal lhs, const Decimal& rhs) { return lhs += rhs; }
+    friend Decimal operator-(Decimal lhs, const Decimal& rhs) { return lhs -= rhs; }
+    friend Decimal operator*(Decimal lhs, const Decimal& rhs) { return lhs *= rhs; }
+    
+    friend bool operator==(const Decimal& a, const Decimal& b) { return a.compare(b) == 0; }
+    friend bool operator!=(const Decimal& a, const Decimal& b) { return a.compare(b) != 0; }
+    friend bool operator<(const Decimal& a, const Decimal& b) { return a.compare(b) < 0; }
+    friend bool operator<=(const Decimal& a, const Decimal& b) { return a.compare(b) <= 0; }
+    friend bool operator>(const Decimal& a, const Decimal& b) { return a.compare(b) > 0; }
+    friend bool operator>=(const Decimal& a, const Decimal& b) { return a.compare(b) >= 0; }
+
+private:
+    struct Wide;  // Sign-magnitude working form of the slow paths
+    
+    [[nodiscard]] static Decimal makeCompact(Coefficient coef, int32_t scale) noexcept;
+    [[nodiscard]] static Decimal fromWide(Wide&& wide);
+    [[nodiscard]] Wide toWide() const;
+    
+    Decimal& addSlow(const Decimal& rhs, bool subtract);
+    Decimal& multiplySlow(const Decimal& rhs);
+};
+
+// Compact fast paths; everything else goes through the out-of-line slow paths
+
+inline Decimal& Decimal::operator+=(const Decimal& rhs) {
+    if (isCompact() && rhs.isCompact() && scale_ == rhs.scale_) {
+        const Coefficient sum = coef_ + rhs.coef_;
+        if (sum < detail::decimalCompactLimit && sum > -detail::decimalCompactLimit) {
+            coef_ = sum;
+            return *this;
+        }
+    }
+    return addSlow(rhs, false);
+}
+
+inline Decimal& Decimal::operator-=(const Decimal& rhs) {
+    if (isCompact() && rhs.isCompact() && scale_ == rhs.scale_) {
+        const Coefficient diff = coef_ - rhs.coef_;
+        if (diff < detail::decimalCompactLimit && diff > -detail::decimalCompactLimit) {
+            coef_ = diff;
+            return *this;
+        }
+    }
+    return addSlow(rhs, true);
+}
+
+/**
+ * @brief Type traits for pq::Decimal (numeric)
+ */
+template<>
+struct PgTypeTraits<Decimal> {
+    static constexpr Oid pgOid = oid::NUMERIC;
+    static constexpr const char* pgTypeName = "numeric";
+    static constexpr bool isNullable = false;
+    static constexpr Oid pgArrayOid = oid::NUMERIC_ARRAY;
+    static constexpr const char* pgArrayTypeName = "numeric[]";
+    
+    [[nodiscard]] static std::string toString(const Decimal& value) {
+        return value.toString();
+    }
+    
+    [[nodiscard]] static Decimal fromString(const char* str) {
+        return Decimal::fromString(str ? std::string_view(str) : std::string_view());
+    }
+    
+    [[nodiscard]] static Decimal fromBinary(const char* data, int length) {
+        return Decimal::fromBinary(data, length);
+    }
+};
+
+} // namespace pq
@@ -0,0 +1,261 @@
+#pragma once
+
+/**
+ * @file Enum.hpp
+ * @brief PostgreSQL ENUM mapping for C++ enums with compile-time lookup tables
+ *
+ * PQ_ENUM declares the label of each enumerator once. From that list the
+ * traits build, at compile time, a perfect hash for label -> enumerator and
+ * a direct table for enumerator -> label, so decoding an enum column costs
+ * one hash and one comparison.
+ *
+ * Usage:
+ * @code
+ * enum class OrderStatus { Pending, Shipped, Cancelled };
+ *
+ * PQ_ENUM(OrderStatus, "order_status",
+ *     PQ_ENUM_VALUE(OrderStatus::Pending, "pending"),
+ *     PQ_ENUM_VALUE(OrderStatus::Shipped, "shipped"),
+ *     PQ_ENUM_VALUE(OrderStatus::Cancelled, "cancelled"))
+ *
+ * auto status = row.get<OrderStatus>("status");
+ * @endcode
+ */
+
+#include "Types.hpp"
+#include "PerfectHash.hpp"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace pq {
+
+/**
+ * @brief One enumerator and its PostgreSQL label
+ */
+template<typename E>
+struct EnumEntry {
+    E value;
+    std::string_view label;
+};
+
+/**
+ * @brief Label table for an enum, specialized by PQ_ENUM
+ *
+ * Specializations provide:
+ * - pgTypeName / pgArrayTypeName: SQL type names
+ * - entries: EnumEntry<E> array in any order
+ */
+template<typename E>
+struct EnumMapping {};
+
+/**
+ * @brief Detect enums declared with PQ_ENUM
+ */
+template<typename E, typename = void>
+struct HasEnumMapping : std::false_type {};
+
+template<typename E>
+struct HasEnumMapping<E, std::void_t<decltype(EnumMapping<E>::entries)>>
+    : std::is_enum<E> {};
+
+template<typename E>
+inline constexpr bool hasEnumMappingV = HasEnumMapping<E>::value;
+
+namespace detail {
+
+/**
+ * @brief Compile-time lookup tables for an enum declared with PQ_ENUM
+ */
+template<typename E>
+struct EnumIndex {
+    static constexpr const auto& entries = EnumMapping<E>::entries;
+    static constexpr std::size_t count = std::extent_v<std::remove_reference_t<decltype(entries)>>;
+    static constexpr std::size_t hashSize = perfectHashTableSize(count);
+    
+    static constexpr std::array<std::string_view, count> labels = [] {
+        std::array<std::string_view, count> out{};
+        for (std::size_t i = 0; i < count; ++i) {
+            out[i] = entries[i].label;
+        }
+        return out;
+    }();
+    
+    static constexpr PerfectHashTable<hashSize> hashTable = buildPerfectHashTable<hashSize>(labels);
+    
+    static constexpr long long minValue = [] {
+        long long v = static_cast<long long>(entries[0].value);
+        for (const auto& e : entries) {
+            v = static_cast<long long>(e.value) < v ? static_cast<long long>(e.value) : v;
+        }
+        return v;
+    }();
+    
+    static constexpr long long maxValue = [] {
+        long long v = static_cast<long long>(entries[0].value);
+        for (const auto& e : entries) {
+            v = static_cast<long long>(e.value) > v ? static_cast<long long>(e.value) : v;
+        }
+        return v;
+    }();
+    
+    // Enumerator -> label is a direct index unless the values are sparse
+    static constexpr bool dense = maxValue - minValue < 256;
+    static constexpr std::size_t labelTableSize =
+        dense ? static_cast<std::size_t>(maxValue - minValue + 1) : 1;
+    
+    static constexpr std::array<std::string_view, labelTableSize> labelTable = [] {
+        std::array<std::string_view, labelTableSize> table{};
+        if (dense) {
+            for (const auto& e : entries) {
+                table[static_cast<std::size_t>(static_cast<long long>(e.value) - minValue)] = e.label;
+            }
+        }
+        return table;
+    }();
+    
+    static constexpr std::size_t maxLabelLength = [] {
+        std::size_t length = 0;
+        for (const auto& e : entries) {
+            length = e.label.size() > length ? e.label.size() : length;
+        }
+        return length;
+    }();
+    
+    /**
+     * @return Pointer to the matching entry, or nullptr for unknown text
+     */
+    [[nodiscard]] static constexpr const EnumEntry<E>* find(std::string_view label) noexcept {
+        const int index = hashTable.find(label, [](std::size_t i) { return labels[i]; });
+        return index < 0 ? nullptr : &entries[index];
+    }
+    
+    /**
+     * @return The label, or an empty view for an unmapped value
+     */
+    [[nodiscard]] static constexpr std::string_view label(E value) noexcept {
+        const auto v = static_cast<long long>(value);
+        if constexpr (dense) {
+            if (v < minValue || v > maxValue) {
+                return {};
+            }
+            return labelTable[static_cast<std::size_t>(v - minValue)];
+        } else {
+            for (const auto& e : entries) {
+                if (e.value == value) {
+                    return e.label;
+                }
+            }
+            return {};
+        }
+    }
+};
+
+/**
+ * @brief Throw for text that is not a label of the enum
+ */
+[[noreturn]] inline void throwInvalidEnumLabel(const char* typeName, std::string_view label) {
+    throw std::invalid_argument(
+        std::string("Invalid input value for enum ") + typeName + ": \"" +
+        std::string(label) + "\"");
+}
+
+} // namespace detail
+
+/**
+ * @brief Type traits for enums declared with PQ_ENUM
+ *
+ * PostgreSQL assigns enum OIDs per database, so pgOid is 0 and parameters
+ * are typed by the server. The binary format of an enum is its label.
+ */
+template<typename E>
+struct PgTypeTraits<E, std::enable_if_t<hasEnumMappingV<E>>> {
+    using Index = detail::EnumIndex<E>;
+    
+    static constexpr Oid pgOid = 0;
+    static constexpr const char* pgTypeName = EnumMapping<E>::pgTypeName;
+    static constexpr bool isNullable = false;
+    static constexpr Oid pgArrayOid = 0;
+    static constexpr const char* pgArrayTypeName = EnumMapping<E>::pgArrayTypeName;
+    static constexpr std::size_t maxTextLength = Index::maxLabelLength;
+    
+    /**
+     * @return Label length, or 0 for a short buffer
+     * @throws std::invalid_argument for a value without a label (an empty
+     *         text would be sent as NULL)
+     */
+    [[nodiscard]] static std::size_t formatTo(E value, char* buf, std::size_t cap) {
+        const std::string_view label = labelOf(value);
+        if (label.size() > cap) {
+            return 0;
+        }
+        std::memcpy(buf, label.data(), label.size());
+        return label.size();
+    }
+    
+    /**
+     * @throws std::invalid_argument for a value without a label
+     */
+    [[nodiscard]] static std::string toString(E value) {
+        return std::string(labelOf(value));
+    }
+    
+    [[nodiscard]] static E fromString(const char* str) {
+        const std::string_view label = str ? std::string_view(str) : std::string_view();
+        if (const auto* entry = Index::find(label)) {
+            return entry->value;
+        }
+        detail::throwInvalidEnumLabel(pgTypeName, label);
+    }
+    
+    [[nodiscard]] static E fromBinary(const char* data, int length) {
+        const std::string_view label(data, static_cast<std::size_t>(length));
+        if (const auto* entry = Index::find(label)) {
+            return entry->value;
+        }
+        detail::throwInvalidEnumLabel(pgTypeName, label);
+    }
+
+private:
+    static std::string_view labelOf(E value) {
+        const std::string_view label = Index::label(value);
+        if (label.empty()) {
+            throw std::invalid_argument(
+                std::string("Unmapped value for enum ") + pgTypeName + ": " +
+                std::to_string(static_cast<long long>(value)));
+        }
+        return label;
+    }
+};
+
+} // namespace pq
+
+// ============================================================================
+// ENUM MAPPING MACROS
+// ============================================================================
+
+/**
+ * @brief One enumerator/label pair for PQ_ENUM
+ */
+#define PQ_ENUM_VALUE(Value, Label) { Value, Label }
+
+/**
+ * @brief Map a C++ enum onto a PostgreSQL ENUM type
+ *
+ * Use at global scope with the fully qualified enum name.
+ *
+ * @param EnumType The C++ enum type
+ * @param TypeName The PostgreSQL type name (string literal)
+ * @param ... PQ_ENUM_VALUE entries
+ */
+#define PQ_ENUM(EnumType, TypeName, ...)                                       \
+    namespace pq {                                                             \
+    template<>                                                                 \
+    struct EnumMapping<EnumType> {                                             \
+        static constexpr const char* pgTypeName = TypeName;                    \
+        static constexpr const char* pgArrayTypeName = TypeName "[]";          \
+        static constexpr EnumEntry<EnumType> entries[] = { __VA_ARGS__ };      \
+    };                                                                         \
+    }
@@ -0,0 +1,206 @@
+#pragma once
+
+/**
+ * @file FixedString.hpp
+ * @brief Inline fixed-capacity string for short text columns
+ *
+ * pq::FixedString<N> stores up to N bytes inside the object, so entities
+ * with short text columns (codes, statuses, SKUs) stay trivially copyable
+ * and mapping them needs no allocation.
+ */
+
+#include "Types.hpp"
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace pq {
+
+/**
+ * @brief What to do with text longer than a FixedString's capacity
+ */
+enum class Overflow {
+    Throw,     // std::length_error
+    Truncate,  // Cut at the last complete UTF-8 character that fits
+};
+
+/**
+ * @brief Inline, null-terminated string of at most N bytes
+ *
+ * Usage:
+ * @code
+ * struct Product {
+ *     int64_t id;
+ *     pq::FixedString<16> sku;
+ *     pq::FixedString<2> country;
+ *     ...
+ * };
+ *
+ * pq::FixedString<8> code("KR-SEOUL");
+ * pq::FixedString<4, pq::Overflow::Truncate> shortCode("KR-SEOUL");  // "KR-S"
+ * @endcode
+ */
+template<std::size_t N, Overflow Policy = Overflow::Throw>
+class FixedString {
+    static_assert(N > 0, "FixedString capacity must be positive");
+    
+    using SizeType = std::conditional_t<(N <= 0xFF), uint8_t,
+                     std::conditional_t<(N <= 0xFFFF), uint16_t, uint32_t>>;
+    
+    char data_[N + 1] = {};
+    SizeType size_ = 0;
+
+public:
+    static constexpr std::size_t capacity = N;
+    static constexpr Overflow overflow = Policy;
+    
+    constexpr FixedString() noexcept = default;
+    
+    /**
+     * @throws std::length_error if text is longer than N and Policy is Throw
+     */
+    constexpr FixedString(std::string_view text) {
+        assign(text);
+    }
+    
+    constexpr FixedString(const char* text)
+        : FixedString(std::string_view(text ? text : "")) {}
+    
+    /**
+     * @brief Keep as much of text as fits, whatever the policy
+     */
+    [[nodiscard]] static constexpr FixedString truncate(std::string_view text) noexcept {
+        FixedString out;
+        out.store(text.data(), fitLength(text));
+        return out;
+    }
+    
+    /**
+     * @throws std::length_error if text is longer than N and Policy is Throw
+     */
+    constexpr void assign(std::string_view text) {
+        if (text.size() > N) {
+            if constexpr (Policy == Overflow::Throw) {
+                throw std::length_error(
+                    "Text of " + std::to_string(text.size()) +
+                    " bytes exceeds FixedString capacity " + std::to_string(N));
+            }
+            store(text.data(), fitLength(text));
+            return;
+        }
+        store(text.data(), text.size());
+    }
+    
+    [[nodiscard]] constexpr const char* data() const noexcept { return data_; }
+    [[nodiscard]] constexpr const char* c_str() const noexcept { return data_; }
+    [[nodiscard]] constexpr std::size_t size() const noexcept { return size_; }
+    [[nodiscard]] constexpr bool empty() const noexcept { return size_ == 0; }
+    
+    [[nodiscard]] constexpr std::string_view view() const noexcept {
+        return std::string_view(data_, size_);
+    }
+    
+    constexpr operator std::string_view() const noexcept { return view(); }
+    
+    [[nodiscard]] std::string str() const { return std::string(data_, size_); }
+    
+    friend constexpr bool operator==(const FixedString& a, const FixedString& b) noexcept {
+        return a.view() == b.view();
+    }
+    friend constexpr bool operator!=(const FixedString& a, const FixedString& b) noexcept {
+        return !(a == b);
+    }
+    friend constexpr bool operator<(const FixedString& a, const FixedString& b) noexcept {
+        return a.view() < b.view();
+    }
+    friend constexpr bool operator==(const FixedString& a, std::string_view b) noexcept {
+        return a.view() == b;
+    }
+    friend constexpr bool operator!=(const FixedString& a, std::string_view b) noexcept {
+        return a.view() != b;
+    }
+    friend constexpr bool operator==(const FixedString& a, const char* b) noexcept {
+        return a.view() == std::string_view(b);
+    }
+    friend constexpr bool operator!=(const FixedString& a, const char* b) noexcept {
+        return a.view() != std::string_view(b);
+    }
+
+private:
+    // Longest prefix of at most N bytes that does not split a UTF-8 sequence
+    static constexpr std::size_t fitLength(std::string_view text) noexcept {
+        if (text.size() <= N) {
+            return text.size();
+        }
+        std::size_t length = N;
+        while (length > 0 && (static_cast<unsigned char>(text[length]) & 0xC0) == 0x80) {
+            --length;
+        }
+        return length;
+    }
+    
+    constexpr void store(const char* text, std::size_t length) noexcept {
+        for (std::size_t i = 0; i < length; ++i) {
+            data_[i] = text[i];
+        }
+        data_[length] = '\0';
+        size_ = static_cast<SizeType>(length);
+    }
+};
+
+/**
+ * @brief Type traits for pq::FixedString<N> (text/varchar)
+ */
+template<std::size_t N, Overflow Policy>
+struct PgTypeTraits<FixedString<N, Policy>> {
+    using Value = FixedString<N, Policy>;
+    
+    static constexpr Oid pgOid = oid::TEXT;
+    static constexpr const char* pgTypeName = "text";
+    static constexpr bool isNullable = false;
+    static constexpr Oid pgArrayOid = oid::TEXT_ARRAY;
+    static constexpr const char* pgArrayTypeName = "text[]";
+    static constexpr std::size_t maxTextLength = N;
+    
+    [[nodiscard]] static std::size_t formatTo(const Value& value, char* buf,
+                                              std::size_t cap) noexcept {
+        if (value.size() > cap) {
+            return 0;
+        }
+        std::memcpy(buf, value.data(), value.size());
+        return value.size();
+    }
+    
+    [[nodiscard]] static std::string toString(const Value& value) {
+        return value.str();
+    }
+    
+    [[nodiscard]] static Value fromString(const char* str) {
+        return Value(std::string_view(str ? str : ""));
+    }
+    
+    [[nodiscard]] static Value fromBinary(const char* data, int length) {
+        return Value(std::string_view(data, static_cast<std::size_t>(length)));
+    }
+    
+    [[nodiscard]] static std::string toBinary(const Value& value) {
+        return value.str();
+    }
+};
+
+} // namespace pq
+
+namespace std {
+
+template<std::size_t N, pq::Overflow Policy>
+struct hash<pq::FixedString<N, Policy>> {
+    std::size_t operator()(const pq::FixedString<N, Policy>& value) const noexcept {
+        return std::hash<std::string_view>{}(value.view());
+    }
+};
+
+} // namespace std
@@ -0,0 +1,34 @@
+#pragma once
+
+/**
+ * @file Hex.hpp
+ * @brief Vectorized hexadecimal encoding and decoding
+ *
+ * Shared by the UUID and bytea codecs. Uses SSE2 where available and falls
+ * back to a table-driven scalar loop elsewhere.
+ */
+
+#include <cstddef>
+
+namespace pq {
+namespace detail {
+
+/**
+ * @brief Encode bytes as lowercase hex
+ * @param in Source bytes
+ * @param size Number of source bytes
+ * @param out Destination, must hold 2 * size characters (not terminated)
+ */
+void hexEncode(const unsigned char* in, std::size_t size, char* out) noexcept;
+
+/**
+ * @brief Decode hex digits (either case) into bytes
+ * @param in Source characters, 2 * size of them
+ * @param size Number of bytes to produce
+ * @param out Destination, must hold size bytes
+ * @return false if any character is not a hex digit
+ */
+[[nodiscard]] bool hexDecode(const char* in, std::size_t size, unsigned char* out) noexcept;
+
+} // namespace detail
+} // namespace pq
@@ -0,0 +1,273 @@
+#pragma once
+
+/**
+ * @file Jsonb.hpp
+ * @brief Lazy jsonb value type with an on-demand JSON scanner
+ *
+ * pq::Jsonb keeps the document text exactly as received and never builds a
+ * DOM. JsonView navigates it on demand, skipping over everything that is not
+ * on the path to the requested value.
+ */
+
+#include "Types.hpp"
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace pq {
+
+namespace detail {
+struct JsonCursor;
+} // namespace detail
+
+/**
+ * @brief Non-owning view of one JSON value inside a document
+ *
+ * The document is only checked as far as it is scanned; malformed input is
+ * reported when it is reached (std::runtime_error).
+ *
+ * Usage:
+ * @code
+ * auto doc = row.get<pq::Jsonb>("payload");
+ * int64_t id = doc["user"]["id"].asInt64();
+ * if (auto tags = doc.root().find("tags")) {
+ *     tags->forEachElement([](pq::JsonView tag) { ... });
+ * }
+ * @endcode
+ */
+class JsonView {
+public:
+    enum class Type : uint8_t {
+        Null,
+        Bool,
+        Number,
+        String,
+        Array,
+        Object,
+    };
+
+private:
+    std::string_view text_;  // Exactly the value's text
+
+public:
+    constexpr JsonView() noexcept = default;
+    
+    /**
+     * @brief View a complete JSON text (surrounding whitespace is ignored)
+     */
+    explicit JsonView(std::string_view text) noexcept;
+    
+    /**
+     * @brief Raw JSON text of this value
+     */
+    [[nodiscard]] std::string_view raw() const noexcept { return text_; }
+    
+    /**
+     * @throws std::runtime_error if the value does not start a JSON value
+     */
+    [[nodiscard]] Type type() const;
+    
+    [[nodiscard]] bool isNull() const noexcept { return text_ == "null"; }
+    [[nodiscard]] bool isObject() const noexcept { return !text_.empty() && text_[0] == '{'; }
+    [[nodiscard]] bool isArray() const noexcept { return !text_.empty() && text_[0] == '['; }
+    
+    /**
+     * @brief Find an object member by key
+     * @return The member value, or std::nullopt if absent
+     * @throws std::runtime_error if this is not an object
+     */
+    [[nodiscard]] std::optional<JsonView> find(std::string_view key) const;
+    
+    /**
+     * @brief Find an array element by position
+     * @return The element, or std::nullopt if out of range
+     * @throws std::runtime_error if this is not an array
+     */
+    [[nodiscard]] std::optional<JsonView> find(std::size_t index) const;
+    
+    /**
+     * @throws std::out_of_range if the key is absent
+     */
+    [[nodiscard]] JsonView operator[](std::string_view key) const;
+    
+    /**
+     * @throws std::out_of_range if the index is out of range
+     */
+    [[nodiscard]] JsonView operator[](std::size_t index) const;
+    
+    /**
+     * @brief Number of elements or members (scans the value)
+     */
+    [[nodiscard]] std::size_t size() const;
+    
+    /**
+     * @brief Call fn(JsonView element) for each array element
+     */
+    template<typename Fn>
+    void forEachElement(Fn&& fn) const;
+    
+    /**
+     * @brief Call fn(std::string key, JsonView value) for each object member
+     */
+    template<typename Fn>
+    void forEachMember(Fn&& fn) const;
+    
+    /**
+     * @throws std::runtime_error on a type mismatch
+     */
+    [[nodiscard]] bool asBool() const;
+    
+    /**
+     * @throws std::runtime_error unless the value is an integer in range
+     */
+    [[nodiscard]] int64_t asInt64() const;
+    
+    [[nodiscard]] double asDouble() const;
+    
+    /**
+     * @brief Unescaped string value
+     */
+    [[nodiscard]] std::string asString() const;
+    
+    friend bool operator==(const JsonView& a, const JsonView& b) noexcept {
+        return a.text_ == b.text_;
+    }
+    friend bool operator!=(const JsonView& a, const JsonView& b) noexcept {
+        return !(a == b);
+    }
+
+private:
+    friend struct detail::JsonCursor;
+    
+    static JsonView fromRange(const char* begin, const char* end) noexcept {
+        JsonView view;
+        view.text_ = std::string_view(begin, static_cast<std::size_t>(end - begin));
+        return view;
+    }
+};
+
+namespace detail {
+
+/**
+ * @brief Sequential reader over the elements or members of a container
+ */
+struct JsonCursor {
+    const char* pos;
+    const char* end;
+    bool done;
+    
+    /**
+     * @throws std::runtime_error if the view does not start with `open`
+     */
+    JsonCursor(std::string_view text, char open);
+    
+    /**
+     * @brief Read the next element of an array
+     * @return false after the last element
+     */
+    bool nextElement(JsonView& value);
+    
+    /**
+     * @brief Read the next member of an object
+     * @param key Receives the quoted key text
+     * @return false after the last member
+     */
+    bool nextMember(JsonView& key, JsonView& value);
+
+private:
+    bool advance(char close);
+};
+
+} // namespace detail
+
+template<typename Fn>
+void JsonView::forEachElement(Fn&& fn) const {
+    detail::JsonCursor cursor(text_, '[');
+    JsonView value;
+    while (cursor.nextElement(value)) {
+        fn(value);
+    }
+}
+
+template<typename Fn>
+void JsonView::forEachMember(Fn&& fn) const {
+    detail::JsonCursor cursor(text_, '{');
+    JsonView key;
+    JsonView value;
+    while (cursor.nextMember(key, value)) {
+        fn(key.asString(), value);
+    }
+}
+
+/**
+ * @brief jsonb value that keeps the document text and parses it lazily
+ */
+class Jsonb {
+    std::string text_;
+
+public:
+    /**
+     * @brief Version byte of the binary jsonb wire format
+     */
+    static constexpr char binaryVersion = 1;
+    
+    Jsonb() = default;
+    
+    /**
+     * @brief Wrap JSON text without parsing it
+     */
+    explicit Jsonb(std::string text) noexcept
+        : text_(std::move(text)) {}
+    
+    /**
+     * @brief Decode the binary jsonb format (version byte plus text)
+     * @throws std::runtime_error on an unknown version
+     */
+    [[nodiscard]] static Jsonb fromBinary(const char* data, int length);
+    
+    [[nodiscard]] const std::string& text() const noexcept { return text_; }
+    
+    [[nodiscard]] JsonView root() const noexcept { return JsonView(text_); }
+    
+    [[nodiscard]] JsonView operator[](std::string_view key) const { return root()[key]; }
+    [[nodiscard]] JsonView operator[](std::size_t index) const { return root()[index]; }
+    
+    friend bool operator==(const Jsonb& a, const Jsonb& b) noexcept { return a.text_ == b.text_; }
+    friend bool operator!=(const Jsonb& a, const Jsonb& b) noexcept { return !(a == b); }
+};
+
+/**
+ * @brief Type traits for pq::Jsonb (jsonb)
+ */
+template<>
+struct PgTypeTraits<Jsonb> {
+    static constexpr Oid pgOid = oid::JSONB;
+    static constexpr const char* pgTypeName = "jsonb";
+    static constexpr bool isNullable = false;
+    static constexpr Oid pgArrayOid = oid::JSONB_ARRAY;
+    static constexpr const char* pgArrayTypeName = "jsonb[]";
+    
+    [[nodiscard]] static const std::string& toString(const Jsonb& value) {
+        return value.text();
+    }
+    
+    [[nodiscard]] static Jsonb fromString(const char* str) {
+        return Jsonb(str ? std::string(str) : std::string());
+    }
+    
+    [[nodiscard]] static Jsonb fromBinary(const char* data, int length) {
+        return Jsonb::fromBinary(data, length);
+    }
+    
+    [[nodiscard]] static std::string toBinary(const Jsonb& value) {
+        std::string out;
+        out.reserve(1 + value.text().size());
+        out.push_back(Jsonb::binaryVersion);
+        out.append(value.text());
+        return out;
+    }
+};
+
+} // namespace pq
@@ -0,0 +1,153 @@
+#pragma once
+
+/**
+ * @file PerfectHash.hpp
+ * @brief Compile-time perfect hashing of short string keys
+ *
+ * Used for the fixed name sets the library knows at compile time (enum
+ * labels, entity column names). Keys are spread over buckets by one hash,
+ * and the builder picks a seed per bucket under which the bucket's keys land
+ * in free slots (hash and displace). There are at least as many buckets as
+ * keys, so each bucket needs only a few tries however many keys there are,
+ * and a lookup is two hashes and one comparison.
+ */
+
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+
+namespace pq {
+namespace detail {
+
+// FNV-1a, seeded so the table builder can search for a collision-free seed
+[[nodiscard]] constexpr uint32_t perfectHash(std::string_view key, uint32_t seed) noexcept {
+    uint32_t hash = 2166136261u ^ seed;
+    for (char c : key) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// Power of two with a load factor of at most one half
+[[nodiscard]] constexpr std::size_t perfectHashTableSize(std::size_t count) noexcept {
+    std::size_t size = 2;
+    while (size < 2 * count) {
+        size <<= 1;
+    }
+    return size;
+}
+
+/**
+ * @brief Slot table in which every key has its own slot
+ */
+template<std::size_t Size>
+struct PerfectHashTable {
+    static constexpr std::size_t bucketCount = Size / 2;
+    
+    std::array<uint16_t, bucketCount> seeds{};  // Slot hash seed of each bucket, minus one
+    std::array<uint16_t, Size> slots{};         // Key index + 1; 0 marks an empty slot
+    
+    [[nodiscard]] static constexpr std::size_t bucketOf(std::string_view key) noexcept {
+        return perfectHash(key, 0) & (bucketCount - 1);
+    }
+    
+    [[nodiscard]] static constexpr std::size_t slotOf(std::string_view key, uint32_t seed) noexcept {
+        return perfectHash(key, seed + 1) & (Size - 1);
+    }
+    
+    /**
+     * @param keyAt Callable returning the string_view key at an index
+     * @return Key index, or -1 if key is not in the table
+     */
+    template<typename KeyAt>
+    [[nodiscard]] constexpr int find(std::string_view key, KeyAt&& keyAt) const noexcept {
+        const uint16_t index = slots[slotOf(key, seeds[bucketOf(key)])];
+        if (index == 0 || keyAt(index - 1) != key) {
+            return -1;
+        }
+        return index - 1;
+    }
+};
+
+/**
+ * @throws std::logic_error for duplicate keys (fails constant evaluation)
+ */
+template<std::size_t Size, std::size_t N>
+constexpr PerfectHashTable<Size> buildPerfectHashTable(const std::array<std::string_view, N>& keys) {
+    static_assert(N < 0xFFFF, "Too many keys");
+    static_assert(Size >= 2 * N, "Table must be at most half full");
+    using Table = PerfectHashTable<Size>;
+    constexpr std::size_t buckets = Table::bucketCount;
+    constexpr uint32_t maxSeeds = 1u << 16;
+    
+    Table table{};
+    if constexpr (N == 0) {
+        return table;
+    } else {
+        // Group key indices by bucket (counting sort)
+        std::array<std::size_t, buckets + 1> begin{};
+        for (std::size_t i = 0; i < N; ++i) {
+            ++begin[Table::bucketOf(keys[i]) + 1];
+        }
+        std::size_t largest = 0;
+        for (std::size_t b = 0; b < buckets; ++b) {
+            largest = begin[b + 1] > largest ? begin[b + 1] : largest;
+            begin[b + 1] += begin[b];
+        }
+        std::array<std::size_t, buckets + 1> fill = begin;
+        std::array<std::size_t, N> members{};
+        for (std::size_t i = 0; i < N; ++i) {
+            members[fill[Table::bucketOf(keys[i])]++] = i;
+        }
+        
+        // Fullest buckets first, while most slots are still free. Each try of a
+        // bucket of k keys succeeds with probability above (1/2)^k, as at least
+        // half of the slots are always free.
+        std::array<std::size_t, N> slotsOf{};
+        for (std::size_t size = largest; size > 0; --size) {
+            for (std::size_t b = 0; b < buckets; ++b) {
+                const std::size_t first = begin[b];
+                if (begin[b + 1] - first != size) {
+                    continue;
+                }
+                for (std::size_t i = first; i < first + size; ++i) {
+                    for (std::size_t j = first; j < i; ++j) {
+                        if (keys[members[i]] == keys[members[j]]) {
+                            throw std::logic_error("Perfect hash keys must be unique");
+                        }
+                    }
+                }
+                
+                uint32_t seed = 0;
+                for (; seed < maxSeeds; ++seed) {
+                    bool placed = true;
+                    for (std::size_t i = first; i < first + size && placed; ++i) {
+                        slotsOf[i] = Table::slotOf(keys[members[i]], seed);
+                        placed = table.slots[slotsOf[i]] == 0;
+                        for (std::size_t j = first; j < i && placed; ++j) {
+                            placed = slotsOf[j] != slotsOf[i];
+                        }
+                    }
+                    if (placed) {
+                        break;
+                    }
+                }
+                if (seed == maxSeeds) {
+                    // Odds below (1 - 2^-k)^65536 for a bucket of k keys
+                    throw std::logic_error("Perfect hash table could not be built");
+                }
+                
+                table.seeds[b] = static_cast<uint16_t>(seed);
+                for (std::size_t i = first; i < first + size; ++i) {
+                    table.slots[slotsOf[i]] = static_cast<uint16_t>(members[i] + 1);
+                }
+            }
+        }
+        return table;
+    }
+}
+
+} // namespace detail
+} // namespace pq
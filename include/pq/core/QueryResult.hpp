@@ -59,6 +59,22 @@ public:
         return PQgetvalue(result_, rowIndex_, columnIndex);
     }
     
+    /**
+     * @brief Get the length in bytes of a column value
+     * @param columnIndex Zero-based column index
+     */
+    [[nodiscard]] int length(int columnIndex) const noexcept {
+        return PQgetlength(result_, rowIndex_, columnIndex);
+    }
+    
+    /**
+     * @brief Get the wire format (text or binary) of a column
+     * @param columnIndex Zero-based column index
+     */
+    [[nodiscard]] Format format(int columnIndex) const noexcept {
+        return static_cast<Format>(PQfformat(result_, columnIndex));
+    }
+    
     /**
      * @brief Get column name by index
      * @param columnIndex Zero-based column index
@@ -81,6 +97,8 @@ public:
      * @tparam T Target type (must have PgTypeTraits specialization)
      * @param columnIndex Zero-based column index
      * @throws std::runtime_error if NULL and T is not optional
+     * 
+     * Binary-format columns are decoded with PgTypeTraits<T>::fromBinary().
      */
     template<typename T>
     [[nodiscard]] T get(int columnIndex) const {
@@ -89,14 +107,16 @@ public:
                 return std::nullopt;
             }
             using Inner = OptionalInnerT<T>;
-            return PgTypeTraits<Inner>::fromString(getRaw(columnIndex));
+            return decodeValue<Inner>(getRaw(columnIndex), length(columnIndex),
+                                      format(columnIndex));
         } else {
             if (isNull(columnIndex)) {
                 throw std::runtime_error(
                     std::string("NULL value in non-optional column: ") + 
                     columnName(columnIndex));
             }
-            return PgTypeTraits<T>::fromString(getRaw(columnIndex));
+            return decodeValue<T>(getRaw(columnIndex), length(columnIndex),
+                                  format(columnIndex));
         }
     }
     
@@ -281,6 +301,13 @@ public:
         return result_ ? PQftype(result_.get(), index) : 0;
     }
     
+    /**
+     * @brief Get the wire format (text or binary) of a column
+     */
+    [[nodiscard]] Format format(int index) const noexcept {
+        return result_ ? static_cast<Format>(PQfformat(result_.get(), index)) : Format::Text;
+    }
+    
     /**
      * @brief Get all column names
      */
@@ -0,0 +1,94 @@
+#pragma once
+
+/**
+ * @file Record.hpp
+ * @brief Codecs for the composite (record) wire formats
+ *
+ * Composite values (table row types, CREATE TYPE ... AS, ROW(...)) arrive as
+ * "(1,\"a b\",)" in text format, or as a field count followed by an
+ * (OID, length, bytes) triple per field in binary format. These readers
+ * split a record into its fields; mapping the fields onto C++ members is
+ * done by the entity traits in orm/Entity.hpp.
+ */
+
+#include "Types.hpp"
+#include <string>
+#include <string_view>
+
+namespace pq {
+namespace detail {
+
+/**
+ * @brief Append one field to record text, quoting it when required
+ *
+ * NULL fields are written by appending nothing.
+ */
+void appendRecordField(std::string& out, std::string_view value);
+
+/**
+ * @brief Tokenizer for the record text format ((a,"b c",))
+ *
+ * Fields are read one at a time; an empty, unquoted field is NULL.
+ */
+class RecordTextParser {
+    const char* pos_;
+    const char* text_;
+    bool started_ = false;
+    bool closed_ = false;
+
+public:
+    /**
+     * @throws std::invalid_argument if the text does not start a record
+     */
+    explicit RecordTextParser(const char* text);
+    
+    /**
+     * @brief Read the next field
+     * @param field Receives the unescaped field text
+     * @param isNull Set when the field is NULL
+     * @throws std::invalid_argument on malformed input or too few fields
+     */
+    void next(std::string& field, bool& isNull);
+    
+    /**
+     * @brief Check that the record has no further fields
+     * @throws std::invalid_argument on extra fields or trailing input
+     */
+    void finish();
+
+private:
+    void close();
+    [[noreturn]] void fail(const char* reason) const;
+};
+
+/**
+ * @brief Reader for the binary record wire format
+ *
+ * Layout: field count, then per field its type OID and a length-prefixed
+ * value (-1 for NULL).
+ */
+class RecordBinaryReader {
+    const char* pos_;
+    const char* end_;
+    int32_t count_ = 0;
+
+public:
+    /**
+     * @throws std::runtime_error on a truncated header or bad field count
+     */
+    RecordBinaryReader(const char* data, int length);
+    
+    [[nodiscard]] int32_t size() const noexcept { return count_; }
+    
+    /**
+     * @brief Read the next field
+     * @param type Receives the field's type OID
+     * @param data Receives the field bytes, or nullptr for NULL
+     * @param length Receives the field length in bytes
+     * @throws std::runtime_error if the field overruns the buffer
+     */
+    void next(Oid& type, const char*& data, int& length);
+};
+
+} // namespace detail
+} // namespace pq
@@ -0,0 +1,101 @@
+#pragma once
+
+/**
+ * @file RowStream.hpp
+ * @brief Row-at-a-time query results using libpq single-row mode
+ *
+ * A regular query keeps every row of the result in one PGresult until the
+ * last one has arrived. RowStream switches the query to single-row mode, so
+ * each row is its own small PGresult that is freed as soon as the caller
+ * moves on, and memory stays flat however many rows the query returns.
+ */
+
+#include "Connection.hpp"
+#include "QueryResult.hpp"
+#include "Result.hpp"
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace pq {
+namespace core {
+
+/**
+ * @brief Streaming cursor over the rows of one query
+ *
+ * The connection is busy until the stream has been read to the end or
+ * closed: no other query can run on it in between.
+ *
+ * Usage:
+ * @code
+ * auto stream = RowStream::open(conn, "SELECT * FROM events");
+ * if (!stream) { // handle error }
+ *
+ * while (auto row = stream->next()) {
+ *     process(row->row(0));
+ * }
+ * if (stream->error()) { // query failed midway }
+ * @endcode
+ */
+class RowStream {
+    Connection* conn_{nullptr};  // Null once the query is finished
+    std::optional<DbError> error_;
+    
+    explicit RowStream(Connection& conn) noexcept : conn_(&conn) {}
+
+public:
+    /**
+     * @brief Send a query and switch it to single-row mode
+     * @param conn Connection to use (must outlive the stream)
+     * @param sql SQL with $1, $2, ... placeholders
+     * @param params Parameter values (empty string = NULL)
+     */
+    [[nodiscard]] static DbResult<RowStream> open(Connection& conn, std::string_view sql,
+                                                  const std::vector<std::string>& params = {});
+    
+    // Move-only semantics
+    RowStream(RowStream&& other) noexcept;
+    RowStream& operator=(RowStream&& other) noexcept;
+    RowStream(const RowStream&) = delete;
+    RowStream& operator=(const RowStream&) = delete;
+    
+    /**
+     * @brief Destructor - closes the stream if rows are left
+     */
+    ~RowStream();
+    
+    /**
+     * @brief Fetch the next row
+     * @return A one-row result, or nullopt at the end or on error (see error())
+     */
+    [[nodiscard]] std::optional<QueryResult> next();
+    
+    /**
+     * @brief Stop early: cancel the query and discard the rows not read yet
+     * 
+     * Inside a transaction the query is not cancelled (that would abort the
+     * transaction); the remaining rows are read and discarded instead.
+     */
+    void close() noexcept;
+    
+    /**
+     * @brief Check if rows may still be read
+     */
+    [[nodiscard]] bool isOpen() const noexcept {
+        return conn_ != nullptr;
+    }
+    
+    /**
+     * @brief Error that ended the stream, if any
+     */
+    [[nodiscard]] const std::optional<DbError>& error() const noexcept {
+        return error_;
+    }
+
+private:
+    void finish() noexcept;
+};
+
+} // namespace core
+} // namespace pq
@@ -0,0 +1,136 @@
+#pragma once
+
+/**
+ * @file TypeRegistry.hpp
+ * @brief Runtime OIDs of database-defined types, resolved once and cached
+ *
+ * Built-in types have fixed OIDs, but ENUM, composite, domain and extension
+ * types get theirs when they are created, so each database assigns different
+ * values. TypeRegistry resolves such types by name with a single pg_type
+ * query and keeps the result, so later lookups never touch the catalog.
+ *
+ * Usage:
+ * @code
+ * pq::PoolConfig config;
+ * config.connectionString = "...";
+ * config.typeNames = {"order_status", "geometry"};  // Resolved on connect
+ * pq::ConnectionPool pool(config);
+ *
+ * Oid statusOid = pool.types().oidOf<OrderStatus>();
+ * @endcode
+ */
+
+#include "Connection.hpp"
+#include "Result.hpp"
+#include "Types.hpp"
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace pq {
+namespace core {
+
+/**
+ * @brief One pg_type entry
+ */
+struct PgTypeInfo {
+    std::string name;   // Name as it was looked up (may be schema-qualified)
+    Oid oid = 0;
+    Oid arrayOid = 0;   // 0 if the type has no array type
+    char kind = 'b';    // pg_type.typtype: b base, c composite, d domain, e enum, r range
+};
+
+/**
+ * @brief Thread-safe cache of type name -> OID
+ *
+ * Lookups take a shared lock; only load() and add() take it exclusively.
+ * Names that do not exist in the database are not cached, so a type created
+ * later is found by the next load().
+ */
+class TypeRegistry {
+    mutable std::shared_mutex mutex_;
+    std::unordered_map<std::string, PgTypeInfo> byName_;
+    std::unordered_map<Oid, std::string> nameByOid_;
+
+public:
+    TypeRegistry() = default;
+    
+    TypeRegistry(const TypeRegistry&) = delete;
+    TypeRegistry& operator=(const TypeRegistry&) = delete;
+    
+    /**
+     * @brief Resolve every name not cached yet with one catalog query
+     *
+     * Names are resolved like a ::regtype cast, so "integer", "public.tag"
+     * and "order_status[]" all work. Unknown names are skipped.
+     */
+    DbResult<void> load(Connection& conn, const std::vector<std::string>& names);
+    
+    /**
+     * @brief Resolve the pgTypeName of every type whose OID is database-assigned
+     */
+    template<typename... Ts>
+    DbResult<void> loadTypes(Connection& conn) {
+        std::vector<std::string> names;
+        (appendTypeName<Ts>(names), ...);
+        return load(conn, names);
+    }
+    
+    /**
+     * @brief Cached lookup, falling back to the catalog on a miss
+     */
+    DbResult<PgTypeInfo> resolve(Connection& conn, std::string_view name);
+    
+    /**
+     * @brief Cached lookup only
+     */
+    [[nodiscard]] std::optional<PgTypeInfo> find(std::string_view name) const;
+    
+    /**
+     * @brief Reverse lookup, e.g. for a result column's PQftype()
+     */
+    [[nodiscard]] std::optional<PgTypeInfo> findByOid(Oid oid) const;
+    
+    /**
+     * @brief OID of T: the fixed pgOid if it has one, else the cached OID
+     *        of its pgTypeName
+     * @return 0 if the type has not been loaded
+     */
+    template<typename T>
+    [[nodiscard]] Oid oidOf() const {
+        if constexpr (PgTypeTraits<T>::pgOid != 0) {
+            return PgTypeTraits<T>::pgOid;
+        } else {
+            const auto info = find(PgTypeTraits<T>::pgTypeName);
+            return info ? info->oid : 0;
+        }
+    }
+    
+    /**
+     * @brief Register an entry without querying (also indexes "name[]")
+     */
+    void add(PgTypeInfo info);
+    
+    /**
+     * @brief Forget every entry, e.g. after DROP TYPE / CREATE TYPE
+     */
+    void clear();
+    
+    [[nodiscard]] std::size_t size() const;
+
+private:
+    void addLocked(PgTypeInfo info);
+    
+    template<typename T>
+    static void appendTypeName(std::vector<std::string>& names) {
+        if constexpr (PgTypeTraits<T>::pgOid == 0) {
+            names.emplace_back(PgTypeTraits<T>::pgTypeName);
+        }
+    }
+};
+
+} // namespace core
+} // namespace pq
@@ -8,13 +8,20 @@
  * and PostgreSQL OIDs, ensuring type safety and preventing SQL injection.
  */
 
+#include <array>
+#include <charconv>
+#include <cmath>
 #include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
 #include <string>
 #include <string_view>
 #include <optional>
 #include <chrono>
 #include <vector>
 #include <type_traits>
+#include <stdexcept>
 #include <libpq-fe.h>
 
 namespace pq {
@@ -39,8 +46,131 @@ namespace oid {
     constexpr Oid NUMERIC   = 1700;
     constexpr Oid UUID      = 2950;
     constexpr Oid JSONB     = 3802;
+    constexpr Oid RECORD    = 2249; // Anonymous composite (ROW(...))
+    
+    // Array types (one-dimensional arrays of the types above)
+    constexpr Oid BOOL_ARRAY    = 1000;
+    constexpr Oid BYTEA_ARRAY   = 1001;
+    constexpr Oid INT2_ARRAY    = 1005;
+    constexpr Oid INT4_ARRAY    = 1007;
+    constexpr Oid TEXT_ARRAY    = 1009;
+    constexpr Oid VARCHAR_ARRAY = 1015;
+    constexpr Oid INT8_ARRAY    = 1016;
+    constexpr Oid FLOAT4_ARRAY  = 1021;
+    constexpr Oid FLOAT8_ARRAY  = 1022;
+    constexpr Oid NUMERIC_ARRAY = 1231;
+    constexpr Oid UUID_ARRAY    = 2951;
+    constexpr Oid JSONB_ARRAY   = 3807;
+    constexpr Oid RECORD_ARRAY  = 2287;
 } // namespace oid
 
+/**
+ * @brief Wire format of a parameter or result column (libpq format codes)
+ */
+enum class Format : int {
+    Text   = 0,
+    Binary = 1,
+};
+
+namespace detail {
+
+// Binary wire values are big-endian (network byte order)
+[[nodiscard]] inline uint16_t readBE16(const char* p) noexcept {
+    const auto* b = reinterpret_cast<const unsigned char*>(p);
+    return static_cast<uint16_t>((b[0] << 8) | b[1]);
+}
+
+[[nodiscard]] inline uint32_t readBE32(const char* p) noexcept {
+    const auto* b = reinterpret_cast<const unsigned char*>(p);
+    return (static_cast<uint32_t>(b[0]) << 24) | (static_cast<uint32_t>(b[1]) << 16) |
+           (static_cast<uint32_t>(b[2]) << 8)  |  static_cast<uint32_t>(b[3]);
+}
+
+[[nodiscard]] inline uint64_t readBE64(const char* p) noexcept {
+    return (static_cast<uint64_t>(readBE32(p)) << 32) | readBE32(p + 4);
+}
+
+inline void appendBE16(std::string& out, uint16_t v) {
+    const char bytes[2] = {static_cast<char>(v >> 8), static_cast<char>(v)};
+    out.append(bytes, sizeof(bytes));
+}
+
+inline void appendBE32(std::string& out, uint32_t v) {
+    const char bytes[4] = {
+        static_cast<char>(v >> 24), static_cast<char>(v >> 16),
+        static_cast<char>(v >> 8),  static_cast<char>(v)
+    };
+    out.append(bytes, sizeof(bytes));
+}
+
+inline void appendBE64(std::string& out, uint64_t v) {
+    appendBE32(out, static_cast<uint32_t>(v >> 32));
+    appendBE32(out, static_cast<uint32_t>(v));
+}
+
+/**
+ * @brief Format a number into a caller buffer with std::to_chars
+ * @return Characters written, or 0 if the buffer is too small
+ */
+template<typename T, typename... Options>
+[[nodiscard]] std::size_t formatChars(char* buf, std::size_t cap, T value,
+                                      Options... options) noexcept {
+    const auto result = std::to_chars(buf, buf + cap, value, options...);
+    return result.ec == std::errc() ? static_cast<std::size_t>(result.ptr - buf) : 0;
+}
+
+/**
+ * @brief Parse a floating-point value exactly with std::from_chars
+ *
+ * Unlike std::stod this accepts subnormals, so every value written by
+ * formatTo() reads back unchanged.
+ *
+ * @throws std::invalid_argument if the text is not a number
+ * @throws std::out_of_range if the value overflows or underflows to zero
+ */
+template<typename T>
+[[nodiscard]] T parseFloat(const char* str, const char* typeName) {
+    const char* begin = str + (str[0] == '+' ? 1 : 0);
+    const char* end = str + std::strlen(str);
+    T value{};
+    const auto result = std::from_chars(begin, end, value);
+    if (result.ec == std::errc::result_out_of_range && result.ptr == end) {
+        // Some from_chars implementations (libstdc++ of GCC 12) also report
+        // subnormals as out of range; strtod rounds them and only sets ERANGE
+        char* parsed = nullptr;
+        if constexpr (std::is_same_v<T, float>) {
+            value = std::strtof(begin, &parsed);
+        } else {
+            value = static_cast<T>(std::strtod(begin, &parsed));
+        }
+        if (parsed == end && value != T(0) && std::fabs(value) < std::numeric_limits<T>::min()) {
+            return value;
+        }
+        throw std::out_of_range(std::string("Value out of range for ") + typeName + ": " + str);
+    }
+    if (result.ec == std::errc::result_out_of_range) {
+        throw std::out_of_range(std::string("Value out of range for ") + typeName + ": " + str);
+    }
+    if (result.ec != std::errc() || result.ptr != end) {
+        throw std::invalid_argument(std::string("Invalid ") + typeName + " value: " + str);
+    }
+    return value;
+}
+
+/**
+ * @brief Throw if a binary value does not have the expected size
+ */
+inline void checkBinaryLength(int actual, int expected, const char* typeName) {
+    if (actual != expected) {
+        throw std::runtime_error(
+            std::string("Invalid binary length for ") + typeName +
+            ": expected " + std::to_string(expected) +
+            ", got " + std::to_string(actual));
+    }
+}
+
+} // namespace detail
+
 /**
  * @brief Primary template for PostgreSQL type traits
  * 
@@ -50,6 +180,12 @@ namespace oid {
  * - isNullable: Whether the type can represent NULL
  * - toString(): Convert C++ value to PostgreSQL text format
  * - fromString(): Parse PostgreSQL text format to C++ value
+ * - fromBinary(): Parse PostgreSQL binary format to C++ value (optional)
+ * - toBinary(): Encode C++ value in PostgreSQL binary format (optional)
+ * - formatTo() / maxTextLength: Write the text format into a caller buffer
+ *   without allocating (optional, fixed-size types)
+ * - pgArrayOid / pgArrayTypeName: Matching array type (optional, enables
+ *   std::vector<T> support, see Array.hpp)
  */
 template<typename T, typename Enable = void>
 struct PgTypeTraits;
@@ -82,6 +218,17 @@ struct PgTypeTraits<bool> {
     static constexpr Oid pgOid = oid::BOOL;
     static constexpr const char* pgTypeName = "boolean";
     static constexpr bool isNullable = false;
+    static constexpr Oid pgArrayOid = oid::BOOL_ARRAY;
+    static constexpr const char* pgArrayTypeName = "boolean[]";
+    static constexpr std::size_t maxTextLength = 1;
+    
+    [[nodiscard]] static std::size_t formatTo(bool value, char* buf, std::size_t cap) noexcept {
+        if (cap < 1) {
+            return 0;
+        }
+        buf[0] = value ? 't' : 'f';
+        return 1;
+    }
     
     [[nodiscard]] static std::string toString(bool value) {
         return value ? "t" : "f";
@@ -90,6 +237,15 @@ struct PgTypeTraits<bool> {
     [[nodiscard]] static bool fromString(const char* str) {
         return str && (str[0] == 't' || str[0] == 'T' || str[0] == '1');
     }
+    
+    [[nodiscard]] static bool fromBinary(const char* data, int length) {
+        detail::checkBinaryLength(length, 1, pgTypeName);
+        return data[0] != 0;
+    }
+    
+    [[nodiscard]] static std::string toBinary(bool value) {
+        return std::string(1, value ? '\1' : '\0');
+    }
 };
 
 /**
@@ -100,14 +256,33 @@ struct PgTypeTraits<int16_t> {
     static constexpr Oid pgOid = oid::INT2;
     static constexpr const char* pgTypeName = "smallint";
     static constexpr bool isNullable = false;
+    static constexpr Oid pgArrayOid = oid::INT2_ARRAY;
+    static constexpr const char* pgArrayTypeName = "smallint[]";
+    static constexpr std::size_t maxTextLength = 6;  // "-32768"
+    
+    [[nodiscard]] static std::size_t formatTo(int16_t value, char* buf, std::size_t cap) noexcept {
+        return detail::formatChars(buf, cap, value);
+    }
     
     [[nodiscard]] static std::string toString(int16_t value) {
-        return std::to_string(value);
+        char buf[maxTextLength];
+        return std::string(buf, formatTo(value, buf, sizeof(buf)));
     }
     
     [[nodiscard]] static int16_t fromString(const char* str) {
         return static_cast<int16_t>(std::stoi(str));
     }
+    
+    [[nodiscard]] static int16_t fromBinary(const char* data, int length) {
+        detail::checkBinaryLength(length, 2, pgTypeName);
+        return static_cast<int16_t>(detail::readBE16(data));
+    }
+    
+    [[nodiscard]] static std::string toBinary(int16_t value) {
+        std::string out;
+        detail::appendBE16(out, static_cast<uint16_t>(value));
+        return out;
+    }
 };
 
 /**
@@ -118,14 +293,33 @@ struct PgTypeTraits<int32_t> {
     static constexpr Oid pgOid = oid::INT4;
     static constexpr const char* pgTypeName = "integer";
     static constexpr bool isNullable = false;
+    static constexpr Oid pgArrayOid = oid::INT4_ARRAY;
+    static constexpr const char* pgArrayTypeName = "integer[]";
+    static constexpr std::size_t maxTextLength = 11;  // "-2147483648"
+    
+    [[nodiscard]] static std::size_t formatTo(int32_t value, char* buf, std::size_t cap) noexcept {
+        return detail::formatChars(buf, cap, value);
+    }
     
     [[nodiscard]] static std::string toString(int32_t value) {
-        return std::to_string(value);
+        char buf[maxTextLength];
+        return std::string(buf, formatTo(value, buf, sizeof(buf)));
     }
     
     [[nodiscard]] static int32_t fromString(const char* str) {
         return std::stoi(str);
     }
+    
+    [[nodiscard]] static int32_t fromBinary(const char* data, int length) {
+        detail::checkBinaryLength(length, 4, pgTypeName);
+        return static_cast<int32_t>(detail::readBE32(data));
+    }
+    
+    [[nodiscard]] static std::string toBinary(int32_t value) {
+        std::string out;
+        detail::appendBE32(out, static_cast<uint32_t>(value));
+        return out;
+    }
 };
 
 // Note: On platforms where int == int32_t (e.g., macOS ARM64), 
@@ -139,14 +333,33 @@ struct PgTypeTraits<int64_t> {
     static constexpr Oid pgOid = oid::INT8;
     static constexpr const char* pgTypeName = "bigint";
     static constexpr bool isNullable = false;
+    static constexpr Oid pgArrayOid = oid::INT8_ARRAY;
+    static constexpr const char* pgArrayTypeName = "bigint[]";
+    static constexpr std::size_t maxTextLength = 20;  // "-9223372036854775808"
+    
+    [[nodiscard]] static std::size_t formatTo(int64_t value, char* buf, std::size_t cap) noexcept {
+        return detail::formatChars(buf, cap, value);
+    }
     
     [[nodiscard]] static std::string toString(int64_t value) {
-        return std::to_string(value);
+        char buf[maxTextLength];
+        return std::string(buf, formatTo(value, buf, sizeof(buf)));
     }
     
     [[nodiscard]] static int64_t fromString(const char* str) {
         return std::stoll(str);
     }
+    
+    [[nodiscard]] static int64_t fromBinary(const char* data, int length) {
+        detail::checkBinaryLength(length, 8, pgTypeName);
+        return static_cast<int64_t>(detail::readBE64(data));
+    }
+    
+    [[nodiscard]] static std::string toBinary(int64_t value) {
+        std::string out;
+        detail::appendBE64(out, static_cast<uint64_t>(value));
+        return out;
+    }
 };
 
 /**
@@ -157,13 +370,40 @@ struct PgTypeTraits<float> {
     static constexpr Oid pgOid = oid::FLOAT4;
     static constexpr const char* pgTypeName = "real";
     static constexpr bool isNullable = false;
+    static constexpr Oid pgArrayOid = oid::FLOAT4_ARRAY;
+    static constexpr const char* pgArrayTypeName = "real[]";
+    static constexpr std::size_t maxTextLength = 15;  // "-1.17549435e-38"
+    
+    /**
+     * @brief Shortest text that reads back as exactly the same value
+     */
+    [[nodiscard]] static std::size_t formatTo(float value, char* buf, std::size_t cap) noexcept {
+        return detail::formatChars(buf, cap, value);
+    }
     
     [[nodiscard]] static std::string toString(float value) {
-        return std::to_string(value);
+        char buf[maxTextLength];
+        return std::string(buf, formatTo(value, buf, sizeof(buf)));
     }
     
     [[nodiscard]] static float fromString(const char* str) {
-        return std::stof(str);
+        return detail::parseFloat<float>(str, pgTypeName);
+    }
+    
+    [[nodiscard]] static float fromBinary(const char* data, int length) {
+        detail::checkBinaryLength(length, 4, pgTypeName);
+        const uint32_t bits = detail::readBE32(data);
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+    
+    [[nodiscard]] static std::string toBinary(float value) {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        std::string out;
+        detail::appendBE32(out, bits);
+        return out;
     }
 };
 
@@ -175,13 +415,40 @@ struct PgTypeTraits<double> {
     static constexpr Oid pgOid = oid::FLOAT8;
     static constexpr const char* pgTypeName = "double precision";
     static constexpr bool isNullable = false;
+    static constexpr Oid pgArrayOid = oid::FLOAT8_ARRAY;
+    static constexpr const char* pgArrayTypeName = "double precision[]";
+    static constexpr std::size_t maxTextLength = 24;  // "-2.2250738585072014e-308"
+    
+    /**
+     * @brief Shortest text that reads back as exactly the same value
+     */
+    [[nodiscard]] static std::size_t formatTo(double value, char* buf, std::size_t cap) noexcept {
+        return detail::formatChars(buf, cap, value);
+    }
     
     [[nodiscard]] static std::string toString(double value) {
-        return std::to_string(value);
+        char buf[maxTextLength];
+        return std::string(buf, formatTo(value, buf, sizeof(buf)));
     }
     
     [[nodiscard]] static double fromString(const char* str) {
-        return std::stod(str);
+        return detail::parseFloat<double>(str, pgTypeName);
+    }
+    
+    [[nodiscard]] static double fromBinary(const char* data, int length) {
+        detail::checkBinaryLength(length, 8, pgTypeName);
+        const uint64_t bits = detail::readBE64(data);
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+    
+    [[nodiscard]] static std::string toBinary(double value) {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        std::string out;
+        detail::appendBE64(out, bits);
+        return out;
     }
 };
 
@@ -193,6 +460,8 @@ struct PgTypeTraits<std::string> {
     static constexpr Oid pgOid = oid::TEXT;
     static constexpr const char* pgTypeName = "text";
     static constexpr bool isNullable = false;
+    static constexpr Oid pgArrayOid = oid::TEXT_ARRAY;
+    static constexpr const char* pgArrayTypeName = "text[]";
     
     [[nodiscard]] static const std::string& toString(const std::string& value) {
         return value;
@@ -201,6 +470,14 @@ struct PgTypeTraits<std::string> {
     [[nodiscard]] static std::string fromString(const char* str) {
         return str ? std::string(str) : std::string();
     }
+    
+    [[nodiscard]] static std::string fromBinary(const char* data, int length) {
+        return std::string(data, static_cast<std::size_t>(length));
+    }
+    
+    [[nodiscard]] static const std::string& toBinary(const std::string& value) {
+        return value;
+    }
 };
 
 /**
@@ -231,6 +508,54 @@ struct PgTypeTraits<std::optional<T>> {
     }
 };
 
+/**
+ * @brief Detect whether PgTypeTraits<T> provides a binary decoder
+ */
+template<typename T, typename = void>
+struct HasBinaryDecoder : std::false_type {};
+
+template<typename T>
+struct HasBinaryDecoder<T, std::void_t<decltype(
+    PgTypeTraits<T>::fromBinary(std::declval<const char*>(), 0))>> : std::true_type {};
+
+template<typename T>
+inline constexpr bool hasBinaryDecoderV = HasBinaryDecoder<T>::value;
+
+/**
+ * @brief Detect whether PgTypeTraits<T> can format into a caller buffer
+ */
+template<typename T, typename = void>
+struct HasFormatTo : std::false_type {};
+
+template<typename T>
+struct HasFormatTo<T, std::void_t<decltype(
+    PgTypeTraits<T>::formatTo(std::declval<const T&>(), std::declval<char*>(), std::size_t{}))>>
+    : std::true_type {};
+
+template<typename T>
+inline constexpr bool hasFormatToV = HasFormatTo<T>::value;
+
+/**
+ * @brief Decode a non-NULL value in the given wire format
+ * @param data Value bytes (null-terminated in text format)
+ * @param length Value length in bytes
+ * @param format Wire format of the value
+ * @throws std::runtime_error if T has no decoder for the format
+ */
+template<typename T>
+[[nodiscard]] T decodeValue(const char* data, int length, Format format) {
+    if (format == Format::Binary) {
+        if constexpr (hasBinaryDecoderV<T>) {
+            return PgTypeTraits<T>::fromBinary(data, length);
+        } else {
+            throw std::runtime_error(
+                std::string("Binary format not supported for type: ") +
+                PgTypeTraits<T>::pgTypeName);
+        }
+    }
+    return PgTypeTraits<T>::fromString(data);
+}
+
 /**
  * @brief Utility to ensure string_view is null-terminated for C API calls
  * 
@@ -261,34 +586,95 @@ public:
     }
 };
 
+/**
+ * @brief Wire format used when T is bound as a parameter
+ * 
+ * Text unless the traits declare `paramFormat = Format::Binary` together
+ * with a toBinaryView() that exposes the value's bytes without copying.
+ * Binary parameters are sent with their OID so the server does not have
+ * to infer the type.
+ */
+template<typename T, typename = void>
+struct ParamFormatOf : std::integral_constant<Format, Format::Text> {};
+
+template<typename T>
+struct ParamFormatOf<T, std::void_t<decltype(PgTypeTraits<T>::paramFormat)>>
+    : std::integral_constant<Format, PgTypeTraits<T>::paramFormat> {};
+
+template<typename T>
+inline constexpr Format paramFormatV = ParamFormatOf<T>::value;
+
+namespace detail {
+
+/**
+ * @brief Inline text buffer size for a parameter of type T
+ */
+template<typename T>
+constexpr std::size_t paramBufferSize() noexcept {
+    if constexpr (hasFormatToV<T>) {
+        return PgTypeTraits<T>::maxTextLength + 1;  // Plus terminator
+    } else {
+        return 1;
+    }
+}
+
+} // namespace detail
+
 /**
  * @brief Helper to convert a value to its PostgreSQL parameter representation
+ * 
+ * Types with formatTo() are formatted into an inline buffer, so ptr may
+ * point into the converter itself; it is therefore not copyable.
+ * Binary parameters borrow the caller's bytes (ptr does not point into
+ * value), so the argument must outlive the query call.
  */
 template<typename T>
 struct ParamConverter {
-    std::string value;
+    std::string value;              // Text of types without formatTo()
     const char* ptr;
     bool isNull;
+    int length = 0;                 // Byte length (binary format only)
+    Format format = Format::Text;
+    Oid type = 0;                   // 0 lets PostgreSQL infer the type
     
     explicit ParamConverter(const T& v)
-        : value(PgTypeTraits<T>::toString(v))
-        , ptr(value.c_str())
-        , isNull(false) {}
+        : isNull(false) {
+        assign(v);
+    }
+    
+    ParamConverter(const ParamConverter&) = delete;
+    ParamConverter& operator=(const ParamConverter&) = delete;
+
+protected:
+    ParamConverter() : ptr(nullptr), isNull(true) {}
+    
+    void assign(const T& v) {
+        if constexpr (paramFormatV<T> == Format::Binary) {
+            const std::string_view bytes = PgTypeTraits<T>::toBinaryView(v);
+            ptr = bytes.data() ? bytes.data() : "";  // nullptr would mean NULL
+            length = static_cast<int>(bytes.size());
+            format = Format::Binary;
+            type = PgTypeTraits<T>::pgOid;
+        } else if constexpr (hasFormatToV<T>) {
+            const std::size_t n = PgTypeTraits<T>::formatTo(v, buffer_.data(), buffer_.size() - 1);
+            buffer_[n] = '\0';
+            ptr = buffer_.data();
+        } else {
+            value = PgTypeTraits<T>::toString(v);
+            ptr = value.c_str();
+        }
+    }
+
+private:
+    std::array<char, detail::paramBufferSize<T>()> buffer_;
 };
 
 template<typename T>
-struct ParamConverter<std::optional<T>> {
-    std::string value;
-    const char* ptr;
-    bool isNull;
-    
-    explicit ParamConverter(const std::optional<T>& v)
-        : isNull(!v.has_value()) {
+struct ParamConverter<std::optional<T>> : ParamConverter<T> {
+    explicit ParamConverter(const std::optional<T>& v) {
         if (v) {
-            value = PgTypeTraits<T>::toString(*v);
-            ptr = value.c_str();
-        } else {
-            ptr = nullptr;
+            this->isNull = false;
+            this->assign(*v);
         }
     }
 };
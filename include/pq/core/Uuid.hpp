@@ -0,0 +1,170 @@
+#pragma once
+
+/**
+ * @file Uuid.hpp
+ * @brief Native 16-byte UUID type for PostgreSQL uuid columns
+ */
+
+#include "Types.hpp"
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace pq {
+
+/**
+ * @brief 128-bit UUID stored inline in network byte order
+ *
+ * Trivially copyable and hashable, so it can replace 36-character
+ * std::string keys without any heap allocation.
+ *
+ * Usage:
+ * @code
+ * auto id = pq::Uuid::fromString("a0eebc99-9c0b-4ef8-bb6d-6bb9bd380a11");
+ * std::unordered_map<pq::Uuid, User> cache;
+ * auto text = id.toString();
+ * @endcode
+ */
+class Uuid {
+public:
+    static constexpr std::size_t size = 16;
+    static constexpr std::size_t textLength = 36;  // 8-4-4-4-12
+    
+    using Bytes = std::array<uint8_t, size>;
+
+private:
+    alignas(8) Bytes bytes_{};
+
+public:
+    /**
+     * @brief Construct the nil UUID (all zero bits)
+     */
+    constexpr Uuid() noexcept = default;
+    
+    constexpr explicit Uuid(const Bytes& bytes) noexcept
+        : bytes_(bytes) {}
+    
+    /**
+     * @brief Construct from 16 raw bytes
+     */
+    [[nodiscard]] static Uuid fromBytes(const void* data) noexcept {
+        Uuid uuid;
+        std::memcpy(uuid.bytes_.data(), data, size);
+        return uuid;
+    }
+    
+    /**
+     * @brief Parse canonical text, with or without hyphens and braces
+     * @throws std::invalid_argument on malformed input
+     */
+    [[nodiscard]] static Uuid fromString(std::string_view text);
+    
+    /**
+     * @brief Decode the binary uuid wire format (16 bytes)
+     * @throws std::runtime_error on a length mismatch
+     */
+    [[nodiscard]] static Uuid fromBinary(const char* data, int length) {
+        detail::checkBinaryLength(length, static_cast<int>(size), "uuid");
+        return fromBytes(data);
+    }
+    
+    /**
+     * @brief Format as lowercase canonical text
+     */
+    [[nodiscard]] std::string toString() const;
+    
+    /**
+     * @brief Write the canonical text form without allocating
+     * @param out Destination, must hold textLength characters (not terminated)
+     */
+    void toChars(char* out) const noexcept;
+    
+    [[nodiscard]] const Bytes& bytes() const noexcept { return bytes_; }
+    [[nodiscard]] const uint8_t* data() const noexcept { return bytes_.data(); }
+    
+    [[nodiscard]] bool isNil() const noexcept {
+        return *this == Uuid();
+    }
+    
+    /**
+     * @brief Hash of the 128-bit value
+     */
+    [[nodiscard]] std::size_t hash() const noexcept {
+        uint64_t high;
+        uint64_t low;
+        std::memcpy(&high, bytes_.data(), 8);
+        std::memcpy(&low, bytes_.data() + 8, 8);
+        uint64_t h = high ^ (low * 0x9E3779B97F4A7C15ULL);
+        h ^= h >> 32;
+        h *= 0xD6E8FEB86659FD93ULL;
+        h ^= h >> 32;
+        return static_cast<std::size_t>(h);
+    }
+    
+    friend bool operator==(const Uuid& a, const Uuid& b) noexcept {
+        return std::memcmp(a.bytes_.data(), b.bytes_.data(), size) == 0;
+    }
+    friend bool operator!=(const Uuid& a, const Uuid& b) noexcept { return !(a == b); }
+    
+    // Byte-wise ordering matches PostgreSQL's uuid comparison
+    friend bool operator<(const Uuid& a, const Uuid& b) noexcept {
+        return std::memcmp(a.bytes_.data(), b.bytes_.data(), size) < 0;
+    }
+    friend bool operator>(const Uuid& a, const Uuid& b) noexcept { return b < a; }
+    friend bool operator<=(const Uuid& a, const Uuid& b) noexcept { return !(b < a); }
+    friend bool operator>=(const Uuid& a, const Uuid& b) noexcept { return !(a < b); }
+};
+
+/**
+ * @brief Type traits for pq::Uuid (uuid)
+ */
+template<>
+struct PgTypeTraits<Uuid> {
+    static constexpr Oid pgOid = oid::UUID;
+    static constexpr const char* pgTypeName = "uuid";
+    static constexpr bool isNullable = false;
+    static constexpr Oid pgArrayOid = oid::UUID_ARRAY;
+    static constexpr const char* pgArrayTypeName = "uuid[]";
+    static constexpr std::size_t maxTextLength = Uuid::textLength;
+    
+    [[nodiscard]] static std::size_t formatTo(const Uuid& value, char* buf,
+                                              std::size_t cap) noexcept {
+        if (cap < Uuid::textLength) {
+            return 0;
+        }
+        value.toChars(buf);
+        return Uuid::textLength;
+    }
+    
+    [[nodiscard]] static std::string toString(const Uuid& value) {
+        return value.toString();
+    }
+    
+    [[nodiscard]] static Uuid fromString(const char* str) {
+        return Uuid::fromString(str ? std::string_view(str) : std::string_view());
+    }
+    
+    [[nodiscard]] static Uuid fromBinary(const char* data, int length) {
+        return Uuid::fromBinary(data, length);
+    }
+    
+    [[nodiscard]] static std::string toBinary(const Uuid& value) {
+        return std::string(reinterpret_cast<const char*>(value.data()), Uuid::size);
+    }
+};
+
+} // namespace pq
+
+namespace std {
+
+template<>
+struct hash<pq::Uuid> {
+    [[nodiscard]] std::size_t operator()(const pq::Uuid& uuid) const noexcept {
+        return uuid.hash();
+    }
+};
+
+} // namespace std
@@ -24,7 +24,11 @@
  */
 
 #include "../core/Types.hpp"
+#include "../core/PerfectHash.hpp"
+#include "../core/Array.hpp"
+#include "../core/Record.hpp"
 #include "../core/QueryResult.hpp"
+#include <array>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -33,6 +37,19 @@
 #include <type_traits>
 
 namespace pq {
+
+namespace detail {
+
+// Leading element of the PQ_COLUMN list, so every PQ_COLUMN can start with a comma
+struct ColumnListBegin {};
+
+template<typename... Columns>
+constexpr std::tuple<Columns...> makeColumnTuple(ColumnListBegin, const Columns&... columns) {
+    return std::tuple<Columns...>(columns...);
+}
+
+} // namespace detail
+
 namespace orm {
 
 /**
@@ -104,12 +121,19 @@ struct IsEntity<T, std::void_t<decltype(EntityMeta<T>::tableName)>> : std::true_
 template<typename T>
 inline constexpr bool isEntityV = IsEntity<T>::value;
 
+class EntityCache;
+
 /**
  * @brief Mapper configuration options
  */
 struct MapperConfig {
     bool strictColumnMapping = true;  // Throw error on unmapped columns
     bool ignoreExtraColumns = false;  // Override strict mapping for extra columns
+    bool usePreparedStatements = true;  // Run Repository CRUD as named prepared statements
+    std::size_t batchSize = 1000;       // Entities per statement in Repository batch operations
+    std::size_t copyThreshold = 10000;  // upsertAll() stages sets this large through COPY
+    bool trackChanges = false;          // Repository::update() writes only columns changed since load
+    EntityCache* entityCache = nullptr; // Shared cache for Repository key lookups (must outlive users)
 };
 
 /**
@@ -139,14 +163,154 @@ struct FieldAccessor {
     }
 };
 
+/**
+ * @brief Split a pointer to data member into its class and field types
+ */
+template<typename T>
+struct MemberPointerTraits;
+
+template<typename Class, typename Field>
+struct MemberPointerTraits<Field Class::*> {
+    using ClassType = Class;
+    using FieldType = Field;
+};
+
+/**
+ * @brief Compile-time descriptor of one mapped member
+ *
+ * The member pointer is a template argument, so reads and writes through a
+ * StaticColumn are direct member accesses with the field's own traits and
+ * inline into the mapping loop. PQ_COLUMN produces one per column.
+ */
+template<auto Member>
+struct StaticColumn {
+    using EntityType = typename MemberPointerTraits<decltype(Member)>::ClassType;
+    using FieldType = typename MemberPointerTraits<decltype(Member)>::FieldType;
+    using Traits = PgTypeTraits<FieldType>;
+    
+    static constexpr bool isNullable = Traits::isNullable;
+    
+    std::string_view fieldName;
+    std::string_view columnName;  // Points at a string literal, so null-terminated
+    ColumnFlags flags = ColumnFlags::None;
+    
+    [[nodiscard]] constexpr bool isPrimaryKey() const noexcept {
+        return hasFlag(flags, ColumnFlags::PrimaryKey);
+    }
+    
+    [[nodiscard]] constexpr bool isAutoIncrement() const noexcept {
+        return hasFlag(flags, ColumnFlags::AutoIncrement);
+    }
+    
+    [[nodiscard]] constexpr ColumnInfo info() const noexcept {
+        return ColumnInfo{fieldName, columnName, Traits::pgOid, flags, isNullable};
+    }
+    
+    [[nodiscard]] static const FieldType& get(const EntityType& e) noexcept {
+        return e.*Member;
+    }
+    
+    [[nodiscard]] static std::string toString(const EntityType& e) {
+        return Traits::toString(e.*Member);
+    }
+    
+    [[nodiscard]] static bool isNull(const EntityType& e) noexcept {
+        if constexpr (isOptionalV<FieldType>) {
+            return !(e.*Member).has_value();
+        } else {
+            return false;
+        }
+    }
+    
+    /**
+     * @param str Text value, or nullptr for NULL
+     */
+    static void fromString(EntityType& e, const char* str) {
+        if constexpr (isOptionalV<FieldType>) {
+            if (str) {
+                e.*Member = PgTypeTraits<typename FieldType::value_type>::fromString(str);
+            } else {
+                e.*Member = std::nullopt;
+            }
+        } else {
+            e.*Member = Traits::fromString(str);
+        }
+    }
+    
+    /**
+     * @param data Binary value, or nullptr for NULL
+     */
+    static void fromBinary(EntityType& e, const char* data, int length) {
+        if constexpr (isOptionalV<FieldType>) {
+            if (data) {
+                e.*Member = decodeValue<typename FieldType::value_type>(
+                    data, length, Format::Binary);
+            } else {
+                e.*Member = std::nullopt;
+            }
+        } else {
+            e.*Member = decodeValue<FieldType>(data, length, Format::Binary);
+        }
+    }
+};
+
+/**
+ * @brief Constant-initialized column list and name index of an entity
+ */
+template<std::size_t N>
+struct ColumnTable {
+    static constexpr std::size_t hashSize = detail::perfectHashTableSize(N);
+    
+    std::array<ColumnInfo, N> columns{};
+    detail::PerfectHashTable<hashSize> nameIndex{};
+    int primaryKey = -1;
+    
+    /**
+     * @return Index of the column, or -1 if the entity has no such column
+     */
+    [[nodiscard]] constexpr int find(std::string_view columnName) const noexcept {
+        return nameIndex.find(columnName, [this](std::size_t i) { return columns[i].columnName; });
+    }
+};
+
+template<typename... Columns>
+constexpr ColumnTable<sizeof...(Columns)> makeColumnTable(const std::tuple<Columns...>& columns) {
+    using Table = ColumnTable<sizeof...(Columns)>;
+    Table table{};
+    std::array<std::string_view, sizeof...(Columns)> names{};
+    std::size_t i = 0;
+    std::apply([&](const auto&... column) {
+        ((table.columns[i] = column.info(),
+          names[i] = column.columnName,
+          table.primaryKey = column.isPrimaryKey() ? static_cast<int>(i) : table.primaryKey,
+          ++i), ...);
+    }, columns);
+    table.nameIndex = detail::buildPerfectHashTable<Table::hashSize>(names);
+    return table;
+}
+
+/**
+ * @brief Column index by name through the entity's constexpr ColumnTable
+ * @return Index in declaration order, or -1
+ */
+template<typename Entity>
+[[nodiscard]] int findColumnIndex(std::string_view columnName) noexcept {
+    static constexpr auto table = Entity::_pqColumnTable();
+    return table.find(columnName);
+}
+
 /**
  * @brief Column descriptor with type-erased getter/setter
+ * 
+ * Kept for runtime introspection; mapping and parameter building go through
+ * the entity's StaticColumn tuple (see forEachColumn).
  */
 template<typename Entity>
 struct ColumnDescriptor {
     ColumnInfo info;
     std::function<std::string(const Entity&)> toString;
     std::function<void(Entity&, const char*)> fromString;
+    std::function<void(Entity&, const char*, int)> fromBinary;
     std::function<bool(const Entity&)> isNull;
 };
 
@@ -157,16 +321,48 @@ template<typename Entity>
 class EntityMetadata {
 public:
     using DescriptorList = std::vector<ColumnDescriptor<Entity>>;
+    using ColumnLookup = int (*)(std::string_view) noexcept;
     
 private:
     std::string_view tableName_;
     DescriptorList columns_;
     std::size_t primaryKeyIndex_{static_cast<std::size_t>(-1)};  // Use index instead of pointer
+    ColumnLookup lookup_{nullptr};  // Perfect-hash name lookup, if built from a ColumnTable
     
 public:
     EntityMetadata(std::string_view tableName)
         : tableName_(tableName) {}
     
+    /**
+     * @brief Build the runtime descriptors from a StaticColumn tuple
+     * @param lookup Name -> index function matching the tuple's order
+     */
+    template<typename... Columns>
+    EntityMetadata(std::string_view tableName, const std::tuple<Columns...>& columns,
+                   ColumnLookup lookup = nullptr)
+        : tableName_(tableName)
+        , lookup_(lookup) {
+        columns_.reserve(sizeof...(Columns));
+        std::apply([this](const auto&... column) { (addColumn(column), ...); }, columns);
+    }
+    
+    template<auto Member>
+    void addColumn(const StaticColumn<Member>& column) {
+        using Column = StaticColumn<Member>;
+        
+        ColumnDescriptor<Entity> desc;
+        desc.info = column.info();
+        desc.toString = &Column::toString;
+        desc.fromString = &Column::fromString;
+        desc.fromBinary = &Column::fromBinary;
+        desc.isNull = &Column::isNull;
+        columns_.push_back(std::move(desc));
+        
+        if (column.isPrimaryKey()) {
+            primaryKeyIndex_ = columns_.size() - 1;
+        }
+    }
+    
     template<typename FieldType>
     void addColumn(std::string_view fieldName,
                    std::string_view columnName,
@@ -197,6 +393,19 @@ public:
             }
         };
         
+        desc.fromBinary = [memberPtr](Entity& e, const char* data, int length) {
+            if constexpr (isOptionalV<FieldType>) {
+                if (data) {
+                    e.*memberPtr = decodeValue<typename FieldType::value_type>(
+                        data, length, Format::Binary);
+                } else {
+                    e.*memberPtr = std::nullopt;
+                }
+            } else {
+                e.*memberPtr = decodeValue<FieldType>(data, length, Format::Binary);
+            }
+        };
+        
         desc.isNull = [memberPtr](const Entity& e) -> bool {
             if constexpr (isOptionalV<FieldType>) {
                 return !(e.*memberPtr).has_value();
@@ -228,6 +437,10 @@ public:
     }
     
     [[nodiscard]] const ColumnDescriptor<Entity>* findColumn(std::string_view name) const {
+        if (lookup_) {
+            const int index = lookup_(name);
+            return index < 0 ? nullptr : &columns_[static_cast<std::size_t>(index)];
+        }
         for (const auto& col : columns_) {
             if (col.info.columnName == name) {
                 return &col;
@@ -237,6 +450,22 @@ public:
     }
 };
 
+/**
+ * @brief Call fn with each StaticColumn of Entity, in declaration order
+ */
+template<typename Entity, typename Fn>
+constexpr void forEachColumn(Fn&& fn) {
+    std::apply([&fn](const auto&... column) { (fn(column), ...); },
+               EntityMeta<Entity>::columns);
+}
+
+/**
+ * @brief Number of mapped columns of Entity
+ */
+template<typename Entity>
+inline constexpr std::size_t columnCountV =
+    std::tuple_size_v<std::decay_t<decltype(EntityMeta<Entity>::columns)>>;
+
 } // namespace orm
 } // namespace pq
 
@@ -264,17 +493,9 @@ public:
     using _PqEntityType = EntityType;                                          \
     static constexpr std::string_view _pqTableName = TableName;                \
                                                                                \
-    static pq::orm::EntityMetadata<EntityType>& _pqMetadata() {                \
-        static pq::orm::EntityMetadata<EntityType> meta(TableName);            \
-        static bool initialized = false;                                       \
-        if (!initialized) {                                                    \
-            initialized = true;                                                \
-            _pqRegisterColumns(meta);                                          \
-        }                                                                      \
-        return meta;                                                           \
-    }                                                                          \
-                                                                               \
-    static void _pqRegisterColumns(pq::orm::EntityMetadata<EntityType>& meta) {
+    static constexpr auto _pqColumns() noexcept {                              \
+        return pq::detail::makeColumnTuple(                               \
+            pq::detail::ColumnListBegin{}
 
 /**
  * @brief Define a column mapping
@@ -284,8 +505,8 @@ public:
  * @param ... Optional flags (PQ_PRIMARY_KEY, PQ_AUTO_INCREMENT, etc.)
  */
 #define PQ_COLUMN(Field, ColumnName, ...)                                      \
-    meta.addColumn(#Field, ColumnName, &_PqEntityType::Field,                  \
-                   pq::orm::ColumnFlags::None __VA_OPT__(|) __VA_ARGS__);
+    , pq::orm::StaticColumn<&_PqEntityType::Field>{                            \
+        #Field, ColumnName, pq::orm::ColumnFlags::None __VA_OPT__(|) __VA_ARGS__}
 
 /**
  * @brief Shorthand for column where C++ field name matches column name
@@ -297,6 +518,19 @@ public:
  * @brief End entity definition
  */
 #define PQ_ENTITY_END()                                                        \
+        );                                                                     \
+    }                                                                          \
+                                                                               \
+    static constexpr auto _pqColumnTable() noexcept {                          \
+        return pq::orm::makeColumnTable(_pqColumns());                         \
+    }                                                                          \
+                                                                               \
+    static pq::orm::EntityMetadata<_PqEntityType>& _pqMetadata() {             \
+        /* Function-local static: initialized once, even on concurrent use */  \
+        static pq::orm::EntityMetadata<_PqEntityType> meta(                    \
+            _pqTableName, _pqColumns(),                                        \
+            &pq::orm::findColumnIndex<_PqEntityType>);                         \
+        return meta;                                                           \
     }
 
 // ============================================================================
@@ -311,9 +545,124 @@ public:
     template<>                                                                 \
     struct EntityMeta<EntityType> {                                            \
         static constexpr std::string_view tableName = EntityType::_pqTableName;\
+        static constexpr auto columns = EntityType::_pqColumns();              \
+        static constexpr auto columnTable = EntityType::_pqColumnTable();      \
                                                                                \
         static EntityMetadata<EntityType>& metadata() {                        \
             return EntityType::_pqMetadata();                                  \
         }                                                                      \
     };                                                                         \
     }}
+
+// ============================================================================
+// COMPOSITE TYPE TRAITS
+// ============================================================================
+
+namespace pq {
+
+/**
+ * @brief Type traits for registered entities as composite values
+ *
+ * A composite value (ROW(...), a table row type, or a CREATE TYPE ... AS
+ * type) is mapped onto the entity's columns in declaration order, so the
+ * projection must list the fields in that order. Entities can be nested and
+ * std::vector<Entity> reads arrays of composites, which loads an object
+ * graph in one query:
+ *
+ * @code
+ * struct Order {
+ *     int64_t id;
+ *     std::vector<OrderLine> lines;
+ *     PQ_ENTITY(Order, "orders")
+ *     PQ_COLUMN(id, "id", PQ_PRIMARY_KEY)
+ *     PQ_COLUMN(lines, "lines")
+ *     PQ_ENTITY_END()
+ * };
+ *
+ * // SELECT o.id, array_agg(ROW(l.sku, l.qty)) AS lines
+ * // FROM orders o JOIN order_lines l ON l.order_id = o.id GROUP BY o.id
+ * @endcode
+ */
+template<typename T>
+struct PgTypeTraits<T, std::enable_if_t<orm::isEntityV<T>>> {
+    static constexpr Oid pgOid = oid::RECORD;
+    static constexpr const char* pgTypeName = "record";
+    static constexpr bool isNullable = false;
+    static constexpr Oid pgArrayOid = oid::RECORD_ARRAY;
+    static constexpr const char* pgArrayTypeName = "record[]";
+    
+    [[nodiscard]] static std::string toString(const T& value) {
+        std::string out;
+        out.push_back('(');
+        bool first = true;
+        orm::forEachColumn<T>([&](const auto& col) {
+            if (!first) {
+                out.push_back(',');
+            }
+            first = false;
+            if (!col.isNull(value)) {
+                detail::appendRecordField(out, col.toString(value));
+            }
+        });
+        out.push_back(')');
+        return out;
+    }
+    
+    [[nodiscard]] static T fromString(const char* str) {
+        detail::RecordTextParser parser(str);
+        T entity{};
+        std::string field;
+        bool isNull = false;
+        orm::forEachColumn<T>([&](const auto& col) {
+            parser.next(field, isNull);
+            if (isNull) {
+                checkNullable(col);
+                col.fromString(entity, nullptr);
+            } else {
+                col.fromString(entity, field.c_str());
+            }
+        });
+        parser.finish();
+        return entity;
+    }
+    
+    [[nodiscard]] static T fromBinary(const char* data, int length) {
+        detail::RecordBinaryReader reader(data, length);
+        constexpr std::size_t count = orm::columnCountV<T>;
+        if (static_cast<std::size_t>(reader.size()) != count) {
+            throw std::runtime_error(
+                "Composite field count mismatch for " + std::string(tableName()) +
+                ": expected " + std::to_string(count) +
+                ", got " + std::to_string(reader.size()));
+        }
+        
+        T entity{};
+        orm::forEachColumn<T>([&](const auto& col) {
+            Oid type = 0;
+            const char* value = nullptr;
+            int valueLength = 0;
+            reader.next(type, value, valueLength);
+            if (!value) {
+                checkNullable(col);
+            }
+            col.fromBinary(entity, value, valueLength);
+        });
+        return entity;
+    }
+
+private:
+    static std::string_view tableName() {
+        return orm::EntityMeta<T>::tableName;
+    }
+    
+    template<typename Column>
+    static void checkNullable(const Column& col) {
+        if (!Column::isNullable) {
+            throw std::runtime_error(
+                "NULL composite field for non-nullable column: " +
+                std::string(tableName()) + "." + std::string(col.columnName));
+        }
+    }
+};
+
+} // namespace pq
@@ -0,0 +1,415 @@
+#pragma once
+
+/**
+ * @file EntityCache.hpp
+ * @brief Process-wide second-level cache of mapped entities
+ *
+ * Reference rows that are read far more often than they change (countries,
+ * plans, settings) cost a query per Repository::findById(). An EntityCache
+ * shared by every repository of the process answers those lookups from
+ * memory. Unlike an IdentityMap it outlives transactions, so it relies on
+ * invalidation: repositories drop the rows they write, and a trigger on the
+ * table sends NOTIFY for changes made anywhere else.
+ */
+
+#include "Entity.hpp"
+#include "Mapper.hpp"
+#include "../core/Connection.hpp"
+#include "../core/Result.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <typeindex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace pq {
+namespace orm {
+
+/**
+ * @brief Configuration options for EntityCache
+ */
+struct EntityCacheConfig {
+    std::size_t maxBytes = 64 * 1024 * 1024;  // Budget over all shards (estimated entity sizes)
+    std::size_t shards = 16;                  // Independently locked LRU lists
+    std::chrono::milliseconds ttl{300000};    // Lifetime of an entry unless set per table
+};
+
+/**
+ * @brief Counters and occupancy of an EntityCache
+ */
+struct EntityCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;      // Dropped to stay within maxBytes
+    uint64_t expirations = 0;    // Found past their TTL
+    uint64_t invalidations = 0;  // Dropped by writes or notifications
+    std::size_t entries = 0;
+    std::size_t bytes = 0;
+    
+    [[nodiscard]] double hitRatio() const noexcept {
+        const uint64_t lookups = hits + misses;
+        return lookups == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(lookups);
+    }
+};
+
+/**
+ * @brief Thread-safe, sharded LRU cache of entities by (table, primary key)
+ *
+ * Keys hash to one of several shards, each an LRU list under its own mutex,
+ * so concurrent lookups of different keys rarely wait on each other. Each
+ * shard gets an equal part of the byte budget and evicts its least recently
+ * used entries when a new one does not fit.
+ *
+ * A fill races with invalidation: a reader may fetch a row just before
+ * another connection's write commits and is invalidated. stamp() taken
+ * before the query and passed to put() makes such a fill a no-op.
+ *
+ * Usage:
+ * @code
+ * static pq::EntityCache cache;  // One per process
+ *
+ * pq::MapperConfig config;
+ * config.entityCache = &cache;
+ * pq::Repository<Country, int> countries(conn, config);
+ *
+ * // Once per table, then one listener thread per process
+ * conn.execute(pq::EntityCache::notifyTriggerSql<Country>());
+ * listenerConn.listen(pq::EntityCache::defaultChannel);
+ * while (running) {
+ *     cache.processNotifications(listenerConn, std::chrono::seconds(1));
+ * }
+ * @endcode
+ */
+class EntityCache {
+public:
+    using Clock = std::chrono::steady_clock;
+    
+    static constexpr const char* defaultChannel = "pq_entity_cache";
+
+private:
+    struct Entry {
+        std::string key;          // Table name, '\0', primary key text
+        std::size_t tableLength;
+        std::type_index type;
+        std::shared_ptr<const void> value;
+        std::size_t bytes;
+        Clock::time_point expires;
+    };
+    
+    struct Shard {
+        std::mutex mutex;
+        std::list<Entry> lru;  // Most recently used first
+        std::unordered_map<std::string_view, std::list<Entry>::iterator> index;  // Views of Entry::key
+        std::size_t bytes = 0;
+        uint64_t invalidations = 0;  // Fills stamped before the last invalidation are dropped
+    };
+    
+    std::vector<Shard> shards_;
+    std::size_t shardBytes_;
+    std::chrono::milliseconds ttl_;
+    
+    mutable std::shared_mutex ttlMutex_;
+    std::unordered_map<std::string, std::chrono::milliseconds> tableTtls_;
+    
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> misses_{0};
+    std::atomic<uint64_t> evictions_{0};
+    std::atomic<uint64_t> expirations_{0};
+    std::atomic<uint64_t> invalidations_{0};
+
+public:
+    explicit EntityCache(const EntityCacheConfig& config = EntityCacheConfig())
+        : shards_(std::max<std::size_t>(1, config.shards))
+        , shardBytes_(config.maxBytes / shards_.size())
+        , ttl_(config.ttl) {}
+    
+    EntityCache(const EntityCache&) = delete;
+    EntityCache& operator=(const EntityCache&) = delete;
+    
+    /**
+     * @brief Look up an entity
+     * @param key Text form of the primary key
+     * @return The entity, or nullptr on a miss (counted in stats())
+     */
+    template<typename Entity>
+    [[nodiscard]] std::shared_ptr<const Entity> get(std::string_view table, std::string_view key) {
+        const std::string fullKey = makeKey(table, key);
+        Shard& shard = shardOf(fullKey);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        
+        auto it = shard.index.find(fullKey);
+        if (it != shard.index.end()) {
+            auto entry = it->second;
+            if (entry->expires <= Clock::now()) {
+                erase(shard, entry);
+                expirations_.fetch_add(1, std::memory_order_relaxed);
+            } else if (entry->type == std::type_index(typeid(Entity))) {
+                shard.lru.splice(shard.lru.begin(), shard.lru, entry);
+                hits_.fetch_add(1, std::memory_order_relaxed);
+                return std::static_pointer_cast<const Entity>(entry->value);
+            }
+        }
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    
+    /**
+     * @brief Invalidation count to pass to put() for a row about to be queried
+     */
+    [[nodiscard]] uint64_t stamp(std::string_view table, std::string_view key) {
+        Shard& shard = shardOf(makeKey(table, key));
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        return shard.invalidations;
+    }
+    
+    /**
+     * @brief Store an entity
+     * @param bytes Estimated memory use of the entity
+     * @param stamp stamp() taken before the entity was read; the entity is
+     *              not stored if its shard was invalidated since
+     */
+    template<typename Entity>
+    void put(std::string_view table, std::string_view key, Entity entity, std::size_t bytes,
+             std::optional<uint64_t> stamp = std::nullopt) {
+        std::string fullKey = makeKey(table, key);
+        bytes += fullKey.size() + sizeof(Entry);
+        if (bytes > shardBytes_) {
+            return;
+        }
+        const auto expires = Clock::now() + ttlOf(table);
+        auto value = std::make_shared<const Entity>(std::move(entity));
+        
+        Shard& shard = shardOf(fullKey);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if (stamp && *stamp != shard.invalidations) {
+            return;
+        }
+        
+        auto it = shard.index.find(fullKey);
+        if (it != shard.index.end()) {
+            erase(shard, it->second);
+        }
+        while (shard.bytes + bytes > shardBytes_ && !shard.lru.empty()) {
+            erase(shard, std::prev(shard.lru.end()));
+            evictions_.fetch_add(1, std::memory_order_relaxed);
+        }
+        
+        shard.lru.push_front(Entry{std::move(fullKey), table.size(), std::type_index(typeid(Entity)),
+                                   std::move(value), bytes, expires});
+        shard.index.emplace(shard.lru.front().key, shard.lru.begin());
+        shard.bytes += bytes;
+    }
+    
+    /**
+     * @brief Drop one entity, e.g. after it was written
+     */
+    void invalidate(std::string_view table, std::string_view key) {
+        const std::string fullKey = makeKey(table, key);
+        Shard& shard = shardOf(fullKey);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        ++shard.invalidations;
+        
+        auto it = shard.index.find(fullKey);
+        if (it != shard.index.end()) {
+            erase(shard, it->second);
+            invalidations_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    
+    /**
+     * @brief Drop every entity of a table, e.g. after a bulk write or TRUNCATE
+     */
+    void invalidateTable(std::string_view table) {
+        for (auto& shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            ++shard.invalidations;
+            
+            for (auto it = shard.lru.begin(); it != shard.lru.end();) {
+                auto next = std::next(it);
+                if (std::string_view(it->key).substr(0, it->tableLength) == table) {
+                    erase(shard, it);
+                    invalidations_.fetch_add(1, std::memory_order_relaxed);
+                }
+                it = next;
+            }
+        }
+    }
+    
+    /**
+     * @brief Drop every entity, e.g. after the listener lost its connection
+     */
+    void clear() {
+        for (auto& shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            ++shard.invalidations;
+            shard.index.clear();
+            shard.lru.clear();
+            shard.bytes = 0;
+        }
+    }
+    
+    /**
+     * @brief Apply a notification from the trigger of notifyTriggerSql()
+     *
+     * The payload is "table:key" for one row, or "table" for the whole table.
+     */
+    void invalidate(const core::Notification& notification) {
+        const std::string_view payload = notification.payload;
+        const std::size_t colon = payload.find(':');
+        if (colon == std::string_view::npos) {
+            invalidateTable(payload);
+        } else {
+            invalidate(payload.substr(0, colon), payload.substr(colon + 1));
+        }
+    }
+    
+    /**
+     * @brief Wait for notifications on a LISTENing connection and apply them
+     * @param conn Connection that has listen()ed on the trigger's channel
+     * @param timeout How long to wait if none are pending
+     * @return Number of notifications applied, or error (the cache may then
+     *         have missed some; reconnect, listen again and clear() it)
+     */
+    DbResult<int> processNotifications(core::Connection& conn, std::chrono::milliseconds timeout) {
+        auto received = conn.notifications(timeout);
+        if (!received) {
+            return DbResult<int>::error(std::move(received).error());
+        }
+        for (const auto& notification : *received) {
+            invalidate(notification);
+        }
+        return static_cast<int>(received->size());
+    }
+    
+    /**
+     * @brief Override the TTL of one table's entries (applies to later puts)
+     */
+    void setTtl(std::string_view table, std::chrono::milliseconds ttl) {
+        std::unique_lock<std::shared_mutex> lock(ttlMutex_);
+        tableTtls_[std::string(table)] = ttl;
+    }
+    
+    [[nodiscard]] EntityCacheStats stats() {
+        EntityCacheStats stats;
+        stats.hits = hits_.load(std::memory_order_relaxed);
+        stats.misses = misses_.load(std::memory_order_relaxed);
+        stats.evictions = evictions_.load(std::memory_order_relaxed);
+        stats.expirations = expirations_.load(std::memory_order_relaxed);
+        stats.invalidations = invalidations_.load(std::memory_order_relaxed);
+        for (auto& shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            stats.entries += shard.lru.size();
+            stats.bytes += shard.bytes;
+        }
+        return stats;
+    }
+    
+    /**
+     * @brief Zero the counters (entries are kept)
+     */
+    void resetStats() noexcept {
+        hits_.store(0, std::memory_order_relaxed);
+        misses_.store(0, std::memory_order_relaxed);
+        evictions_.store(0, std::memory_order_relaxed);
+        expirations_.store(0, std::memory_order_relaxed);
+        invalidations_.store(0, std::memory_order_relaxed);
+    }
+    
+    /**
+     * @brief SQL creating the trigger that notifies caches of changes to an entity's table
+     *
+     * Rows updated or deleted send "table:key", TRUNCATE sends "table". The
+     * key is the primary key's output text (format('%s'), which keeps
+     * char(n) padding that ::text would trim), the same text a repository
+     * reads back; repositories cache only rows whose key text it equals.
+     * Inserts send nothing, as the cache holds no negative entries. The
+     * notifications are delivered when the writing transaction commits.
+     * Run it once per table, e.g. in a migration.
+     */
+    template<typename Entity>
+    [[nodiscard]] static std::string notifyTriggerSql(std::string_view channel = defaultChannel) {
+        const int pk = EntityMeta<Entity>::columnTable.primaryKey;
+        if (pk < 0) {
+            throw std::logic_error("Entity has no primary key");
+        }
+        const std::string table(EntityMeta<Entity>::tableName);
+        const std::string column(EntityMeta<Entity>::columnTable.columns[pk].columnName);
+        const std::string function = detail::statementName(table, "notify", std::string(channel));
+        const std::string channelLiteral = quoteLiteral(channel);
+        const std::string tableLiteral = quoteLiteral(table);
+        
+        std::string sql;
+        sql += "CREATE OR REPLACE FUNCTION " + function + "() RETURNS trigger AS $pq$\n";
+        sql += "BEGIN\n";
+        sql += "    IF TG_OP = 'TRUNCATE' THEN\n";
+        sql += "        PERFORM pg_notify(" + channelLiteral + ", " + tableLiteral + ");\n";
+        sql += "    ELSE\n";
+        sql += "        PERFORM pg_notify(" + channelLiteral + ", " + tableLiteral +
+               " || ':' || format('%s', OLD." + column + "));\n";
+        sql += "    END IF;\n";
+        sql += "    RETURN NULL;\n";
+        sql += "END\n";
+        sql += "$pq$ LANGUAGE plpgsql;\n";
+        sql += "DROP TRIGGER IF EXISTS " + function + " ON " + table + ";\n";
+        sql += "CREATE TRIGGER " + function + " AFTER UPDATE OR DELETE ON " + table +
+               " FOR EACH ROW EXECUTE PROCEDURE " + function + "();\n";
+        sql += "DROP TRIGGER IF EXISTS " + function + "_truncate ON " + table + ";\n";
+        sql += "CREATE TRIGGER " + function + "_truncate AFTER TRUNCATE ON " + table +
+               " FOR EACH STATEMENT EXECUTE PROCEDURE " + function + "();\n";
+        return sql;
+    }
+
+private:
+    static std::string makeKey(std::string_view table, std::string_view key) {
+        std::string fullKey;
+        fullKey.reserve(table.size() + 1 + key.size());
+        fullKey.append(table);
+        fullKey.push_back('\0');
+        fullKey.append(key);
+        return fullKey;
+    }
+    
+    static std::string quoteLiteral(std::string_view value) {
+        std::string out = "'";
+        for (char c : value) {
+            out.push_back(c);
+            if (c == '\'') {
+                out.push_back('\'');
+            }
+        }
+        out.push_back('\'');
+        return out;
+    }
+    
+    Shard& shardOf(std::string_view fullKey) {
+        return shards_[std::hash<std::string_view>()(fullKey) % shards_.size()];
+    }
+    
+    std::chrono::milliseconds ttlOf(std::string_view table) const {
+        std::shared_lock<std::shared_mutex> lock(ttlMutex_);
+        auto it = tableTtls_.find(std::string(table));
+        return it != tableTtls_.end() ? it->second : ttl_;
+    }
+    
+    static void erase(Shard& shard, std::list<Entry>::iterator entry) {
+        shard.index.erase(entry->key);
+        shard.bytes -= entry->bytes;
+        shard.lru.erase(entry);
+    }
+};
+
+} // namespace orm
+} // namespace pq
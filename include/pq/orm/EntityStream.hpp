@@ -0,0 +1,135 @@
+#pragma once
+
+/**
+ * @file EntityStream.hpp
+ * @brief Entities mapped one row at a time from a RowStream
+ */
+
+#include "Entity.hpp"
+#include "Mapper.hpp"
+#include "../core/Result.hpp"
+#include "../core/RowStream.hpp"
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <utility>
+
+namespace pq {
+namespace orm {
+
+/**
+ * @brief Input range of entities backed by a single-row mode query
+ *
+ * Each row is mapped when it is reached and its result freed before the next
+ * one is read, so only the current entity is held in memory. The mapping plan
+ * is built from the first row and reused for the rest.
+ *
+ * Iteration stops at the end of the rows or at the first error; check error()
+ * afterwards to tell the two apart.
+ *
+ * Usage:
+ * @code
+ * auto users = userRepo.stream();
+ * if (!users) { // handle error }
+ *
+ * for (const User& user : *users) {
+ *     process(user);
+ * }
+ * if (users->error()) { // handle error }
+ * @endcode
+ */
+template<typename Entity>
+class EntityStream {
+    core::RowStream rows_;
+    EntityMapper<Entity> mapper_;
+    std::optional<MappingPlan<Entity>> plan_;
+    std::optional<DbError> error_;
+
+public:
+    class Iterator {
+        EntityStream* stream_{nullptr};  // Null for the end iterator
+        std::optional<Entity> current_;
+    
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = Entity;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Entity*;
+        using reference = const Entity&;
+        
+        Iterator() = default;
+        
+        explicit Iterator(EntityStream& stream)
+            : stream_(&stream) {
+            ++*this;
+        }
+        
+        [[nodiscard]] reference operator*() const { return *current_; }
+        [[nodiscard]] pointer operator->() const { return &*current_; }
+        
+        Iterator& operator++() {
+            current_ = stream_->next();
+            if (!current_) {
+                stream_ = nullptr;
+            }
+            return *this;
+        }
+        
+        [[nodiscard]] bool operator==(const Iterator& other) const noexcept {
+            return stream_ == other.stream_;
+        }
+        
+        [[nodiscard]] bool operator!=(const Iterator& other) const noexcept {
+            return stream_ != other.stream_;
+        }
+    };
+    
+    EntityStream(core::RowStream rows, const MapperConfig& config)
+        : rows_(std::move(rows))
+        , mapper_(config) {}
+    
+    /**
+     * @brief Read and map the next entity
+     * @return Entity, or nullopt at the end or on error (see error())
+     */
+    [[nodiscard]] std::optional<Entity> next() {
+        auto row = rows_.next();
+        if (!row) {
+            if (rows_.error()) {
+                error_ = rows_.error();
+            }
+            return std::nullopt;
+        }
+        
+        try {
+            if (!plan_) {
+                plan_ = mapper_.plan(*row);
+            }
+            return mapper_.mapRow(row->row(0), *plan_);
+        } catch (const MappingException& e) {
+            error_ = DbError{e.what()};
+            rows_.close();
+            return std::nullopt;
+        }
+    }
+    
+    [[nodiscard]] Iterator begin() { return Iterator(*this); }
+    [[nodiscard]] Iterator end() { return Iterator(); }
+    
+    /**
+     * @brief Stop early; the connection is usable again afterwards
+     */
+    void close() noexcept {
+        rows_.close();
+    }
+    
+    /**
+     * @brief Error that ended the stream, if any
+     */
+    [[nodiscard]] const std::optional<DbError>& error() const noexcept {
+        return error_;
+    }
+};
+
+} // namespace orm
+} // namespace pq
@@ -0,0 +1,164 @@
+#pragma once
+
+/**
+ * @file IdentityMap.hpp
+ * @brief Unit-of-work cache of entities by type and primary key
+ *
+ * Within one request or transaction the same entity is often loaded several
+ * times. Repositories sharing an IdentityMap serve repeat findById() and
+ * findByIds() lookups from it instead of querying again. It is meant to live
+ * as long as that unit of work, not the process: nothing outside the
+ * repositories that use it can invalidate it.
+ */
+
+#include "../core/Connection.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+#include <utility>
+
+namespace pq {
+namespace orm {
+
+/**
+ * @brief Entities loaded in one unit of work, keyed by (entity type, primary key)
+ *
+ * Repositories constructed with the map record every entity they read or
+ * write, drop the ones they remove, and evict their entity type after
+ * writes whose rows they do not get back (upsertAll()). A rollback on the
+ * connection, including to a savepoint, clears the whole map.
+ *
+ * Writes made with custom SQL or by other connections are not seen; call
+ * clear() after them.
+ *
+ * Usage:
+ * @code
+ * pq::IdentityMap identities(conn);
+ * pq::Repository<User, int> users(identities);
+ * pq::Repository<Order, int> orders(identities);
+ *
+ * auto first = users.findById(1);   // SELECT
+ * auto again = users.findById(1);   // Served from the map
+ * @endcode
+ */
+class IdentityMap {
+    core::Connection* conn_;
+    uint64_t rollbacks_;  // Connection rollback count the entries are valid for
+    
+    // Entries of one entity type, behind a type-erased pointer
+    struct Entries {
+        std::shared_ptr<void> table;
+        std::size_t (*size)(const void* table);
+    };
+    std::unordered_map<std::type_index, Entries> tables_;
+
+public:
+    /**
+     * @param conn Connection of the repositories using the map (must outlive it)
+     */
+    explicit IdentityMap(core::Connection& conn) noexcept
+        : conn_(&conn)
+        , rollbacks_(conn.rollbackCount()) {}
+    
+    // Repositories keep a pointer to the map, so it stays where it was created
+    IdentityMap(const IdentityMap&) = delete;
+    IdentityMap& operator=(const IdentityMap&) = delete;
+    
+    /**
+     * @brief Look up an entity by the text form of its primary key
+     * @return The entity, or nullptr if it is not in the map
+     */
+    template<typename Entity>
+    [[nodiscard]] const Entity* find(const std::string& key) {
+        sync();
+        auto* entries = table<Entity>(false);
+        if (!entries) {
+            return nullptr;
+        }
+        auto it = entries->find(key);
+        return it != entries->end() ? &it->second : nullptr;
+    }
+    
+    /**
+     * @brief Record the current state of an entity
+     */
+    template<typename Entity>
+    void put(const std::string& key, const Entity& entity) {
+        sync();
+        (*table<Entity>(true))[key] = entity;
+    }
+    
+    /**
+     * @brief Drop one entity
+     */
+    template<typename Entity>
+    void erase(const std::string& key) {
+        if (auto* entries = table<Entity>(false)) {
+            entries->erase(key);
+        }
+    }
+    
+    /**
+     * @brief Drop every entity of one type
+     */
+    template<typename Entity>
+    void evict() noexcept {
+        tables_.erase(std::type_index(typeid(Entity)));
+    }
+    
+    /**
+     * @brief Drop every entity
+     */
+    void clear() noexcept {
+        tables_.clear();
+    }
+    
+    /**
+     * @brief Number of entities held, over all types
+     */
+    [[nodiscard]] std::size_t size() noexcept {
+        sync();
+        std::size_t total = 0;
+        for (const auto& entry : tables_) {
+            total += entry.second.size(entry.second.table.get());
+        }
+        return total;
+    }
+    
+    [[nodiscard]] core::Connection& connection() noexcept {
+        return *conn_;
+    }
+
+private:
+    template<typename Entity>
+    using Table = std::unordered_map<std::string, Entity>;
+    
+    // Entries may have been rolled back since they were read or written
+    void sync() noexcept {
+        if (conn_->rollbackCount() != rollbacks_) {
+            tables_.clear();
+            rollbacks_ = conn_->rollbackCount();
+        }
+    }
+    
+    template<typename Entity>
+    Table<Entity>* table(bool create) {
+        auto it = tables_.find(std::type_index(typeid(Entity)));
+        if (it == tables_.end()) {
+            if (!create) {
+                return nullptr;
+            }
+            Entries entries{std::make_shared<Table<Entity>>(), [](const void* table) {
+                return static_cast<const Table<Entity>*>(table)->size();
+            }};
+            it = tables_.emplace(std::type_index(typeid(Entity)), std::move(entries)).first;
+        }
+        return static_cast<Table<Entity>*>(it->second.table.get());
+    }
+};
+
+} // namespace orm
+} // namespace pq
@@ -9,10 +9,18 @@
  */
 
 #include "Entity.hpp"
+#include "Page.hpp"
+#include "../core/Connection.hpp"
 #include "../core/QueryResult.hpp"
 #include "../core/Result.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <optional>
 #include <stdexcept>
-#include <set>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 namespace pq {
 namespace orm {
@@ -26,6 +34,20 @@ public:
         : std::runtime_error(msg) {}
 };
 
+/**
+ * @brief Positions of an entity's columns in one query result
+ * 
+ * Built once per result by EntityMapper::plan(), in entity declaration
+ * order, so every row is then mapped positionally without name lookups.
+ */
+template<typename Entity>
+struct MappingPlan {
+    static constexpr std::size_t size = columnCountV<Entity>;
+    
+    std::array<int, size> index{};       // Result column of each entity column
+    std::array<Format, size> format{};   // Text or binary decoder
+};
+
 /**
  * @brief Maps query results to entity objects
  */
@@ -48,36 +70,31 @@ public:
      * @throws MappingException if strict mapping fails
      */
     [[nodiscard]] Entity mapRow(const core::Row& row) const {
-        // Validate columns if strict mapping is enabled
-        if (config_.strictColumnMapping && !config_.ignoreExtraColumns) {
-            validateColumns(row);
-        }
-        
+        return mapRow(row, buildPlan(row));
+    }
+    
+    /**
+     * @brief Map a row of a result that plan was built for
+     */
+    [[nodiscard]] Entity mapRow(const core::Row& row, const MappingPlan<Entity>& plan) const {
         Entity entity{};
-        
-        for (const auto& col : meta_.columns()) {
-            int idx = row.columnIndex(col.info.columnName.data());
-            if (idx < 0) {
-                throw MappingException(
-                    std::string("Required column not found in result: ") +
-                    std::string(col.info.columnName));
-            }
-            
-            if (row.isNull(idx)) {
-                if (!col.info.isNullable) {
-                    throw MappingException(
-                        std::string("NULL value in non-nullable column: ") +
-                        std::string(col.info.columnName));
-                }
-                col.fromString(entity, nullptr);
-            } else {
-                col.fromString(entity, row.getRaw(idx));
-            }
-        }
-        
+        std::size_t i = 0;
+        forEachColumn<Entity>([&](const auto& col) {
+            mapColumn(col, row, plan.index[i], plan.format[i], entity);
+            ++i;
+        });
         return entity;
     }
     
+    /**
+     * @brief Resolve column positions and validate columns once for a result
+     * @throws MappingException if a column is missing, or an extra column is
+     *         present in strict mode
+     */
+    [[nodiscard]] MappingPlan<Entity> plan(const core::QueryResult& result) const {
+        return buildPlan(result);
+    }
+    
     /**
      * @brief Map all rows in a result to entities
      * @param result Query result
@@ -85,10 +102,15 @@ public:
      */
     [[nodiscard]] std::vector<Entity> mapAll(const core::QueryResult& result) const {
         std::vector<Entity> entities;
+        if (result.empty()) {
+            return entities;
+        }
+        
+        const auto resultPlan = buildPlan(result);
         entities.reserve(result.rowCount());
         
         for (const auto& row : result) {
-            entities.push_back(mapRow(row));
+            entities.push_back(mapRow(row, resultPlan));
         }
         
         return entities;
@@ -101,47 +123,278 @@ public:
         if (result.empty()) {
             return std::nullopt;
         }
-        return mapRow(result[0]);
+        return mapRow(result[0], buildPlan(result));
     }
     
     /**
      * @brief Validate that result columns match entity columns (strict mode)
      */
     void validateColumns(const core::Row& row) const {
-        std::set<std::string> resultColumns;
-        for (int i = 0; i < row.columnCount(); ++i) {
-            resultColumns.insert(row.columnName(i));
+        checkExtraColumns(row);
+    }
+    
+    /**
+     * @brief Get the metadata for this mapper
+     */
+    [[nodiscard]] const EntityMetadata<Entity>& metadata() const noexcept {
+        return meta_;
+    }
+
+private:
+    // Source is a QueryResult or a Row: both expose the result's columns
+    template<typename Source>
+    [[nodiscard]] MappingPlan<Entity> buildPlan(const Source& source) const {
+        if (config_.strictColumnMapping && !config_.ignoreExtraColumns) {
+            checkExtraColumns(source);
         }
         
-        std::set<std::string> entityColumns;
-        for (const auto& col : meta_.columns()) {
-            entityColumns.insert(std::string(col.info.columnName));
+        MappingPlan<Entity> plan;
+        std::size_t i = 0;
+        forEachColumn<Entity>([&](const auto& col) {
+            const int idx = source.columnIndex(col.columnName.data());
+            if (idx < 0) {
+                throw MappingException(
+                    std::string("Required column not found in result: ") +
+                    std::string(col.columnName));
+            }
+            plan.index[i] = idx;
+            plan.format[i] = source.format(idx);
+            ++i;
+        });
+        return plan;
+    }
+    
+    template<typename Source>
+    void checkExtraColumns(const Source& source) const {
+        for (int i = 0; i < source.columnCount(); ++i) {
+            const std::string_view name = source.columnName(i);
+            if (findColumnIndex<Entity>(name) < 0) {
+                throw MappingException(
+                    "Result contains column not mapped to entity: " + std::string(name));
+            }
         }
-        
-        // Check for extra columns in result
-        for (const auto& col : resultColumns) {
-            if (entityColumns.find(col) == entityColumns.end()) {
+    }
+    
+    template<typename Column>
+    static void mapColumn(const Column& col, const core::Row& row, int idx, Format format,
+                          Entity& entity) {
+        if (row.isNull(idx)) {
+            if constexpr (Column::isNullable) {
+                col.fromString(entity, nullptr);
+            } else {
                 throw MappingException(
-                    "Result contains column not mapped to entity: " + col);
+                    std::string("NULL value in non-nullable column: ") +
+                    std::string(col.columnName));
             }
+        } else if (format == Format::Binary) {
+            col.fromBinary(entity, row.getRaw(idx), row.length(idx));
+        } else {
+            col.fromString(entity, row.getRaw(idx));
+        }
+    }
+};
+
+/**
+ * @brief A generated statement and the entity column behind each parameter
+ */
+struct StatementLayout {
+    std::string name;  // Prepared statement name, stable across processes
+    std::string sql;
+    std::vector<int> params;  // params[n - 1]: column index (declaration order) for $n
+};
+
+} // namespace orm
+
+namespace detail {
+
+/**
+ * @brief Prepared statement name for generated SQL: "pq_<table>_<kind>_<sql hash>"
+ *
+ * The hash keeps two entities that share a table name apart, and changes
+ * with the SQL, so a rebuilt binary never runs a stale statement of the
+ * same name. The table part is clipped to keep the name under NAMEDATALEN.
+ */
+inline std::string statementName(std::string_view table, std::string_view kind,
+                                 std::string_view sql) {
+    constexpr std::size_t maxTableChars = 32;
+    static constexpr char hex[] = "0123456789abcdef";
+    
+    std::string name = "pq_";
+    for (char c : table.substr(0, maxTableChars)) {
+        const bool plain = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+                           (c >= '0' && c <= '9');
+        name += plain ? c : '_';
+    }
+    name += '_';
+    name += kind;
+    name += '_';
+    const uint32_t hash = perfectHash(sql, 0);
+    for (int shift = 28; shift >= 0; shift -= 4) {
+        name += hex[(hash >> shift) & 0xF];
+    }
+    return name;
+}
+
+/**
+ * @brief Drop repeated keys, keeping the first occurrence of each
+ * @return Position in keys of each distinct key, in order of first appearance
+ */
+inline std::vector<std::size_t> distinctKeys(const std::vector<std::string>& keys) {
+    std::unordered_map<std::string_view, std::size_t> seen;
+    std::vector<std::size_t> positions;
+    seen.reserve(keys.size());
+    positions.reserve(keys.size());
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        if (seen.emplace(keys[i], i).second) {
+            positions.push_back(i);
         }
     }
+    return positions;
+}
+
+/**
+ * @brief Change-tracking snapshots of loaded rows, by primary key text
+ *
+ * A snapshot written inside a transaction that is rolled back no longer
+ * matches the row. Every access passes the connection's rollbackCount(),
+ * and all snapshots are dropped once it has moved.
+ */
+class ChangeSnapshots {
+public:
+    using ColumnValues = std::vector<std::optional<std::string>>;
+    
+    explicit ChangeSnapshots(uint64_t rollbacks = 0) noexcept
+        : rollbacks_(rollbacks) {}
     
     /**
-     * @brief Get the metadata for this mapper
+     * @return The snapshot, or nullptr if there is none or it may be rolled back
      */
-    [[nodiscard]] const EntityMetadata<Entity>& metadata() const noexcept {
-        return meta_;
+    [[nodiscard]] const ColumnValues* find(const std::string& key, uint64_t rollbacks) {
+        sync(rollbacks);
+        auto it = values_.find(key);
+        return it != values_.end() ? &it->second : nullptr;
+    }
+    
+    void put(std::string key, ColumnValues values, uint64_t rollbacks) {
+        sync(rollbacks);
+        values_[std::move(key)] = std::move(values);
+    }
+    
+    void erase(const std::string& key) {
+        values_.erase(key);
+    }
+    
+    void clear() noexcept {
+        values_.clear();
+    }
+
+private:
+    void sync(uint64_t rollbacks) noexcept {
+        if (rollbacks != rollbacks_) {
+            values_.clear();
+            rollbacks_ = rollbacks;
+        }
     }
+    
+    std::unordered_map<std::string, ColumnValues> values_;
+    uint64_t rollbacks_;
 };
 
+/**
+ * @brief Keep the last of the rows that share a key
+ * @param keys Key of each row; std::nullopt for a row that shares no key
+ *        (e.g. a NULL in a unique constraint)
+ * @return Positions of the rows kept, in order
+ */
+inline std::vector<std::size_t> lastPerKey(const std::vector<std::optional<std::string>>& keys) {
+    std::unordered_map<std::string_view, std::size_t> last;
+    last.reserve(keys.size());
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        if (keys[i]) {
+            last[*keys[i]] = i;
+        }
+    }
+    
+    std::vector<std::size_t> kept;
+    kept.reserve(last.size());
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        if (!keys[i] || last[*keys[i]] == i) {
+            kept.push_back(i);
+        }
+    }
+    return kept;
+}
+
+/**
+ * @brief Match the rows of a pk = ANY($1) lookup to the keys[begin, end) it sent
+ *
+ * A row goes to the key its primary key text equals. The server may spell a
+ * key differently from the client (char(n) padding, citext case), so when
+ * one row and one key are left over after that, they are paired. Rows left
+ * over beyond that cannot be told apart and stay unmatched.
+ *
+ * @param rowKeys Primary key text of each row, read back from the mapped entity
+ * @return Index into keys for each row, or std::nullopt
+ */
+inline std::vector<std::optional<std::size_t>> matchRowKeys(
+        const std::vector<std::string>& keys, std::size_t begin, std::size_t end,
+        const std::vector<std::string>& rowKeys) {
+    std::unordered_map<std::string_view, std::size_t> pending;
+    pending.reserve(end - begin);
+    for (std::size_t i = begin; i < end; ++i) {
+        pending.emplace(keys[i], i);
+    }
+    
+    std::vector<std::optional<std::size_t>> matches(rowKeys.size());
+    std::size_t unmatched = 0;
+    std::size_t lastUnmatched = 0;
+    for (std::size_t row = 0; row < rowKeys.size(); ++row) {
+        auto it = pending.find(rowKeys[row]);
+        if (it != pending.end()) {
+            matches[row] = it->second;
+            pending.erase(it);
+        } else {
+            ++unmatched;
+            lastUnmatched = row;
+        }
+    }
+    if (unmatched == 1 && pending.size() == 1) {
+        matches[lastUnmatched] = pending.begin()->second;
+    }
+    return matches;
+}
+
+} // namespace detail
+
+namespace orm {
+
 /**
  * @brief SQL generation utilities for entities
+ * 
+ * Statements are generated once per entity type, on first use, and shared
+ * by every SqlBuilder and Repository of that type.
  */
 template<typename Entity>
 class SqlBuilder {
     static_assert(isEntityV<Entity>, "Entity must be registered with PQ_REGISTER_ENTITY");
     
+    struct Statements {
+        bool hasPrimaryKey = false;
+        std::string tableName;
+        std::string insertColumns;  // "a, b" without auto-increment columns
+        std::string insertWithAutoIncrementColumns;
+        StatementLayout insert;
+        StatementLayout insertWithAutoIncrement;
+        StatementLayout selectAll;
+        StatementLayout selectById;
+        StatementLayout selectByIds;
+        StatementLayout update;
+        StatementLayout remove;
+        StatementLayout removeByIds;
+        StatementLayout existsById;
+        StatementLayout count;
+    };
+    
     const EntityMetadata<Entity>& meta_;
     
 public:
@@ -152,90 +405,281 @@ public:
      * @brief Generate INSERT SQL
      * @param includeAutoIncrement Whether to include auto-increment columns
      */
-    [[nodiscard]] std::string insertSql(bool includeAutoIncrement = false) const {
-        std::string cols;
-        std::string vals;
-        int paramIndex = 1;
-        
-        for (const auto& col : meta_.columns()) {
-            if (!includeAutoIncrement && col.info.isAutoIncrement()) {
-                continue;
-            }
-            
-            if (!cols.empty()) {
-                cols += ", ";
-                vals += ", ";
-            }
-            
-            cols += col.info.columnName;
-            vals += "$" + std::to_string(paramIndex++);
-        }
-        
-        return "INSERT INTO " + std::string(meta_.tableName()) +
-               " (" + cols + ") VALUES (" + vals + ") RETURNING *";
+    [[nodiscard]] const std::string& insertSql(bool includeAutoIncrement = false) const {
+        return insertLayout(includeAutoIncrement).sql;
     }
     
     /**
      * @brief Generate SELECT all SQL
      */
-    [[nodiscard]] std::string selectAllSql() const {
-        return "SELECT * FROM " + std::string(meta_.tableName());
+    [[nodiscard]] const std::string& selectAllSql() const {
+        return statements().selectAll.sql;
     }
     
     /**
      * @brief Generate SELECT by primary key SQL
      */
-    [[nodiscard]] std::string selectByIdSql() const {
-        const auto* pk = meta_.primaryKey();
-        if (!pk) {
-            throw std::logic_error("Entity has no primary key defined");
-        }
-        
-        return "SELECT * FROM " + std::string(meta_.tableName()) +
-               " WHERE " + std::string(pk->info.columnName) + " = $1";
+    [[nodiscard]] const std::string& selectByIdSql() const {
+        return withPrimaryKey(statements().selectById).sql;
     }
     
     /**
      * @brief Generate UPDATE SQL
      */
-    [[nodiscard]] std::string updateSql() const {
-        const auto* pk = meta_.primaryKey();
-        if (!pk) {
-            throw std::logic_error("Entity has no primary key defined");
-        }
+    [[nodiscard]] const std::string& updateSql() const {
+        return updateLayout().sql;
+    }
+    
+    /**
+     * @brief Generate DELETE SQL
+     */
+    [[nodiscard]] const std::string& deleteSql() const {
+        return withPrimaryKey(statements().remove).sql;
+    }
+    
+    /**
+     * @brief Generate existence check by primary key SQL
+     */
+    [[nodiscard]] const std::string& existsByIdSql() const {
+        return withPrimaryKey(statements().existsById).sql;
+    }
+    
+    /**
+     * @brief Generate COUNT(*) SQL
+     */
+    [[nodiscard]] const std::string& countSql() const {
+        return statements().count.sql;
+    }
+    
+    /**
+     * @brief INSERT statement with its parameter layout
+     */
+    [[nodiscard]] const StatementLayout& insertLayout(bool includeAutoIncrement = false) const {
+        return includeAutoIncrement ? statements().insertWithAutoIncrement
+                                    : statements().insert;
+    }
+    
+    /**
+     * @brief UPDATE statement with its parameter layout (values, then primary key)
+     */
+    [[nodiscard]] const StatementLayout& updateLayout() const {
+        return withPrimaryKey(statements().update);
+    }
+    
+    /**
+     * @brief UPDATE of only the given columns (values, then primary key)
+     * 
+     * Used for partial updates from change tracking; the primary key is
+     * never set even if listed.
+     */
+    [[nodiscard]] StatementLayout updateLayout(const std::vector<int>& columns) const {
+        constexpr const auto& table = EntityMeta<Entity>::columnTable;
+        const auto& all = withPrimaryKey(statements().update);
+        const int pk = table.primaryKey;
         
+        StatementLayout layout;
         std::string sets;
-        int paramIndex = 1;
-        
-        for (const auto& col : meta_.columns()) {
-            if (col.info.isPrimaryKey()) {
-                continue;  // Don't update primary key
+        for (const int column : columns) {
+            if (column == pk) {
+                continue;
             }
-            
             if (!sets.empty()) {
                 sets += ", ";
             }
-            
-            sets += std::string(col.info.columnName) + " = $" + std::to_string(paramIndex++);
+            layout.params.push_back(column);
+            sets += std::string(table.columns[column].columnName) + " = $" +
+                    std::to_string(layout.params.size());
+        }
+        if (layout.params.empty()) {
+            return all;
+        }
+        layout.params.push_back(pk);
+        layout.sql = "UPDATE " + statements().tableName + " SET " + sets + " WHERE " +
+                     std::string(table.columns[pk].columnName) + " = $" +
+                     std::to_string(layout.params.size()) + " RETURNING *";
+        nameStatement(layout, statements().tableName, "update_cols");
+        return layout;
+    }
+    
+    /**
+     * @brief Multi-row INSERT for a batch of entities
+     * 
+     * Generates INSERT ... VALUES (...), (...) RETURNING *; parameters are the
+     * insertParams() of each entity in turn, and PostgreSQL returns the rows
+     * of a plain multi-row INSERT in VALUES order.
+     * 
+     * @param rows Number of entities in the batch
+     */
+    [[nodiscard]] StatementLayout insertBatchLayout(std::size_t rows,
+                                                    bool includeAutoIncrement = false) const {
+        return buildValuesInsert(rows, includeAutoIncrement, " RETURNING *", "insert_batch");
+    }
+    
+    /**
+     * @brief Multi-row upsert: INSERT ... VALUES ... ON CONFLICT (...) DO UPDATE
+     * 
+     * Every inserted column outside conflictColumns is set from EXCLUDED; if
+     * there is none, conflicting rows are skipped (DO NOTHING). Auto-increment
+     * columns are inserted only when they are part of the conflict target.
+     * Parameters are appendInsertParams(entity, params, includesAutoIncrement(...))
+     * of each entity in turn.
+     * 
+     * @param rows Number of entities in the batch
+     * @param conflictColumns Column indices of a unique constraint (declaration order)
+     */
+    [[nodiscard]] StatementLayout upsertLayout(std::size_t rows,
+                                               const std::vector<int>& conflictColumns) const {
+        const bool includeAutoIncrement = includesAutoIncrement(conflictColumns);
+        return buildValuesInsert(rows, includeAutoIncrement,
+                                 conflictClause(conflictColumns, includeAutoIncrement), "upsert");
+    }
+    
+    /**
+     * @brief Upsert from another table with the insert columns, e.g. a COPY staging table
+     * 
+     * With orderColumn, rows sharing a conflict key are reduced to the one
+     * with the highest orderColumn (SELECT DISTINCT ON), since one statement
+     * cannot update a row twice. Rows with a NULL in the key are all kept.
+     */
+    [[nodiscard]] std::string upsertFromSql(std::string_view sourceTable,
+                                            const std::vector<int>& conflictColumns,
+                                            std::string_view orderColumn = {}) const {
+        const bool includeAutoIncrement = includesAutoIncrement(conflictColumns);
+        const std::string& cols = insertColumns(includeAutoIncrement);
+        if (orderColumn.empty()) {
+            return "INSERT INTO " + statements().tableName + " (" + cols + ") SELECT " + cols +
+                   " FROM " + std::string(sourceTable) +
+                   conflictClause(conflictColumns, includeAutoIncrement);
         }
         
-        return "UPDATE " + std::string(meta_.tableName()) +
-               " SET " + sets +
-               " WHERE " + std::string(pk->info.columnName) + " = $" + std::to_string(paramIndex) +
-               " RETURNING *";
+        constexpr const auto& table = EntityMeta<Entity>::columnTable;
+        std::string anyNull;
+        for (const int index : conflictColumns) {
+            if (!anyNull.empty()) {
+                anyNull += " OR ";
+            }
+            anyNull += std::string(table.columns[index].columnName) + " IS NULL";
+        }
+        const std::string key = conflictTarget(conflictColumns) + ", CASE WHEN " + anyNull +
+                                " THEN " + std::string(orderColumn) + " END";
+        return "INSERT INTO " + statements().tableName + " (" + cols + ") SELECT DISTINCT ON (" +
+               key + ") " + cols + " FROM " + std::string(sourceTable) + " ORDER BY " + key +
+               ", " + std::string(orderColumn) + " DESC" +
+               conflictClause(conflictColumns, includeAutoIncrement);
     }
     
     /**
-     * @brief Generate DELETE SQL
+     * @brief Comma-separated insert column names
      */
-    [[nodiscard]] std::string deleteSql() const {
-        const auto* pk = meta_.primaryKey();
-        if (!pk) {
-            throw std::logic_error("Entity has no primary key defined");
+    [[nodiscard]] const std::string& insertColumns(bool includeAutoIncrement = false) const {
+        return includeAutoIncrement ? statements().insertWithAutoIncrementColumns
+                                    : statements().insertColumns;
+    }
+    
+    /**
+     * @brief Whether an upsert on these columns must insert auto-increment columns
+     */
+    [[nodiscard]] static bool includesAutoIncrement(const std::vector<int>& conflictColumns) {
+        constexpr const auto& table = EntityMeta<Entity>::columnTable;
+        return std::any_of(conflictColumns.begin(), conflictColumns.end(), [](int index) {
+            return table.columns[index].isAutoIncrement();
+        });
+    }
+    
+    /**
+     * @brief Keyset page query ordered by the given columns
+     * 
+     * Generates SELECT * FROM t [WHERE (a, b) > ($1, $2)] ORDER BY a, b LIMIT $n
+     * (< and DESC for SortOrder::Descending). params lists the sort columns
+     * of the WHERE clause; the LIMIT parameter follows them.
+     * 
+     * @param columns Sort column indices (declaration order); should end in a unique key
+     * @param after Whether to continue after a previous page's last key
+     */
+    [[nodiscard]] StatementLayout pageLayout(const std::vector<int>& columns, bool after,
+                                             SortOrder order = SortOrder::Ascending) const {
+        constexpr const auto& table = EntityMeta<Entity>::columnTable;
+        const bool descending = order == SortOrder::Descending;
+        
+        std::string keys;
+        std::string placeholders;
+        std::string orderBy;
+        for (std::size_t i = 0; i < columns.size(); ++i) {
+            if (i > 0) {
+                keys += ", ";
+                placeholders += ", ";
+                orderBy += ", ";
+            }
+            const std::string_view name = table.columns[columns[i]].columnName;
+            keys += name;
+            placeholders += "$" + std::to_string(i + 1);
+            orderBy += name;
+            if (descending) {
+                orderBy += " DESC";
+            }
         }
         
-        return "DELETE FROM " + std::string(meta_.tableName()) +
-               " WHERE " + std::string(pk->info.columnName) + " = $1";
+        StatementLayout layout;
+        layout.sql = "SELECT * FROM " + statements().tableName;
+        if (after) {
+            layout.sql += " WHERE (" + keys + ") " + (descending ? "<" : ">") +
+                          " (" + placeholders + ")";
+            layout.params = columns;
+        }
+        layout.sql += " ORDER BY " + orderBy + " LIMIT $" + std::to_string(layout.params.size() + 1);
+        nameStatement(layout, statements().tableName, "page");
+        return layout;
+    }
+    
+    /**
+     * @brief SELECT by primary key statement with its parameter layout
+     */
+    [[nodiscard]] const StatementLayout& selectByIdLayout() const {
+        return withPrimaryKey(statements().selectById);
+    }
+    
+    /**
+     * @brief SELECT by a key array: SELECT ... WHERE pk = ANY($1)
+     */
+    [[nodiscard]] const StatementLayout& selectByIdsLayout() const {
+        return withPrimaryKey(statements().selectByIds);
+    }
+    
+    /**
+     * @brief DELETE statement with its parameter layout
+     */
+    [[nodiscard]] const StatementLayout& deleteLayout() const {
+        return withPrimaryKey(statements().remove);
+    }
+    
+    /**
+     * @brief DELETE by a key array: DELETE ... WHERE pk = ANY($1)
+     * 
+     * $1 is a primary key array in text form, e.g. "{1,2,3}".
+     */
+    [[nodiscard]] const StatementLayout& deleteByIdsLayout() const {
+        return withPrimaryKey(statements().removeByIds);
+    }
+    
+    /**
+     * @brief Existence check statement with its parameter layout
+     */
+    [[nodiscard]] const StatementLayout& existsByIdLayout() const {
+        return withPrimaryKey(statements().existsById);
+    }
+    
+    /**
+     * @brief SELECT all statement
+     */
+    [[nodiscard]] const StatementLayout& selectAllLayout() const {
+        return statements().selectAll;
+    }
+    
+    /**
+     * @brief COUNT(*) statement
+     */
+    [[nodiscard]] const StatementLayout& countLayout() const {
+        return statements().count;
     }
     
     /**
@@ -244,10 +688,19 @@ public:
     [[nodiscard]] std::vector<std::string> insertParams(const Entity& entity,
                                                          bool includeAutoIncrement = false) const {
         std::vector<std::string> params;
-        
-        for (const auto& col : meta_.columns()) {
-            if (!includeAutoIncrement && col.info.isAutoIncrement()) {
-                continue;
+        params.reserve(columnCountV<Entity>);
+        appendInsertParams(entity, params, includeAutoIncrement);
+        return params;
+    }
+    
+    /**
+     * @brief Append parameters for INSERT, e.g. one row of a batch
+     */
+    void appendInsertParams(const Entity& entity, std::vector<std::string>& params,
+                            bool includeAutoIncrement = false) const {
+        forEachColumn<Entity>([&](const auto& col) {
+            if (!includeAutoIncrement && col.isAutoIncrement()) {
+                return;
             }
             
             if (col.isNull(entity)) {
@@ -255,9 +708,37 @@ public:
             } else {
                 params.push_back(col.toString(entity));
             }
-        }
-        
-        return params;
+        });
+    }
+    
+    /**
+     * @brief Append the insert columns of one row in COPY text format
+     * 
+     * Fields are tab-separated, with no row terminator, and written straight
+     * into out: types with PgTypeTraits::formatTo() go through a stack
+     * buffer. NULL is written as \N; an empty string stays an empty string.
+     */
+    void appendCopyFields(const Entity& entity, std::string& out,
+                          bool includeAutoIncrement = false) const {
+        bool first = true;
+        forEachColumn<Entity>([&](const auto& col) {
+            if (!includeAutoIncrement && col.isAutoIncrement()) {
+                return;
+            }
+            if (!first) {
+                out.push_back('\t');
+            }
+            first = false;
+            
+            using Field = typename std::decay_t<decltype(col)>::FieldType;
+            if (col.isNull(entity)) {
+                out += "\\N";
+            } else if constexpr (isOptionalV<Field>) {
+                appendCopyValue(out, *col.get(entity));
+            } else {
+                appendCopyValue(out, col.get(entity));
+            }
+        });
     }
     
     /**
@@ -265,11 +746,15 @@ public:
      */
     [[nodiscard]] std::vector<std::string> updateParams(const Entity& entity) const {
         std::vector<std::string> params;
-        const auto* pk = meta_.primaryKey();
+        params.reserve(columnCountV<Entity>);
+        std::string pkValue;
+        bool hasPk = false;
         
-        for (const auto& col : meta_.columns()) {
-            if (col.info.isPrimaryKey()) {
-                continue;
+        forEachColumn<Entity>([&](const auto& col) {
+            if (col.isPrimaryKey()) {
+                pkValue = col.toString(entity);
+                hasPk = true;
+                return;
             }
             
             if (col.isNull(entity)) {
@@ -277,25 +762,63 @@ public:
             } else {
                 params.push_back(col.toString(entity));
             }
-        }
+        });
         
         // Add primary key as last parameter
-        if (pk) {
-            params.push_back(pk->toString(entity));
+        if (hasPk) {
+            params.push_back(std::move(pkValue));
         }
         
         return params;
     }
     
+    /**
+     * @brief Text value of one column, by declaration index
+     * @return Value, or nullopt if it is NULL
+     */
+    [[nodiscard]] std::optional<std::string> columnValue(const Entity& entity, int index) const {
+        std::optional<std::string> value;
+        int i = 0;
+        forEachColumn<Entity>([&](const auto& col) {
+            if (i++ == index && !col.isNull(entity)) {
+                value = col.toString(entity);
+            }
+        });
+        return value;
+    }
+    
+    /**
+     * @brief Text value of every column in declaration order (nullopt for NULL)
+     */
+    [[nodiscard]] std::vector<std::optional<std::string>> columnValues(const Entity& entity) const {
+        std::vector<std::optional<std::string>> values;
+        values.reserve(columnCountV<Entity>);
+        forEachColumn<Entity>([&](const auto& col) {
+            if (col.isNull(entity)) {
+                values.emplace_back();
+            } else {
+                values.emplace_back(col.toString(entity));
+            }
+        });
+        return values;
+    }
+    
     /**
      * @brief Get primary key value as string
      */
     [[nodiscard]] std::string primaryKeyValue(const Entity& entity) const {
-        const auto* pk = meta_.primaryKey();
-        if (!pk) {
+        std::string value;
+        bool hasPk = false;
+        forEachColumn<Entity>([&](const auto& col) {
+            if (!hasPk && col.isPrimaryKey()) {
+                value = col.toString(entity);
+                hasPk = true;
+            }
+        });
+        if (!hasPk) {
             throw std::logic_error("Entity has no primary key defined");
         }
-        return pk->toString(entity);
+        return value;
     }
     
     /**
@@ -304,6 +827,203 @@ public:
     [[nodiscard]] const EntityMetadata<Entity>& metadata() const noexcept {
         return meta_;
     }
+
+private:
+    template<typename T>
+    static void appendCopyValue(std::string& out, const T& value) {
+        if constexpr (hasFormatToV<T>) {
+            char buf[PgTypeTraits<T>::maxTextLength];
+            const std::size_t n = PgTypeTraits<T>::formatTo(value, buf, sizeof(buf));
+            detail::appendCopyField(out, std::string_view(buf, n));
+        } else {
+            detail::appendCopyField(out, PgTypeTraits<T>::toString(value));
+        }
+    }
+    
+    static const Statements& statements() {
+        static const Statements cached = buildStatements();
+        return cached;
+    }
+    
+    static const StatementLayout& withPrimaryKey(const StatementLayout& layout) {
+        if (!statements().hasPrimaryKey) {
+            throw std::logic_error("Entity has no primary key defined");
+        }
+        return layout;
+    }
+    
+    static Statements buildStatements() {
+        constexpr const auto& table = EntityMeta<Entity>::columnTable;
+        const std::string tableName(EntityMeta<Entity>::tableName);
+        const int pk = table.primaryKey;
+        
+        Statements out;
+        out.hasPrimaryKey = pk >= 0;
+        out.tableName = tableName;
+        out.insertColumns = buildInsertColumns(false);
+        out.insertWithAutoIncrementColumns = buildInsertColumns(true);
+        out.insert = buildInsert(tableName, out.insertColumns, false);
+        out.insertWithAutoIncrement = buildInsert(tableName, out.insertWithAutoIncrementColumns, true);
+        out.selectAll.sql = "SELECT * FROM " + tableName;
+        out.count.sql = "SELECT COUNT(*) FROM " + tableName;
+        
+        if (pk >= 0) {
+            const std::string pkName(table.columns[pk].columnName);
+            
+            out.selectById.sql = "SELECT * FROM " + tableName + " WHERE " + pkName + " = $1";
+            out.selectById.params = {pk};
+            
+            out.selectByIds.sql = "SELECT * FROM " + tableName + " WHERE " + pkName + " = ANY($1)";
+            out.selectByIds.params = {pk};
+            
+            out.remove.sql = "DELETE FROM " + tableName + " WHERE " + pkName + " = $1";
+            out.remove.params = {pk};
+            
+            out.removeByIds.sql = "DELETE FROM " + tableName + " WHERE " + pkName + " = ANY($1)";
+            out.removeByIds.params = {pk};
+            
+            out.existsById.sql = "SELECT 1 FROM " + tableName + " WHERE " + pkName + " = $1 LIMIT 1";
+            out.existsById.params = {pk};
+            
+            std::string sets;
+            for (int i = 0; i < static_cast<int>(table.columns.size()); ++i) {
+                if (i == pk) {
+                    continue;  // Don't update primary key
+                }
+                if (!sets.empty()) {
+                    sets += ", ";
+                }
+                out.update.params.push_back(i);
+                sets += std::string(table.columns[i].columnName) + " = $" +
+                        std::to_string(out.update.params.size());
+            }
+            out.update.params.push_back(pk);
+            out.update.sql = "UPDATE " + tableName + " SET " + sets +
+                             " WHERE " + pkName + " = $" +
+                             std::to_string(out.update.params.size()) + " RETURNING *";
+        }
+        
+        nameStatement(out.insert, tableName, "insert");
+        nameStatement(out.insertWithAutoIncrement, tableName, "insert_all");
+        nameStatement(out.selectAll, tableName, "find_all");
+        nameStatement(out.count, tableName, "count");
+        nameStatement(out.selectById, tableName, "find_by_id");
+        nameStatement(out.selectByIds, tableName, "find_by_ids");
+        nameStatement(out.remove, tableName, "delete");
+        nameStatement(out.removeByIds, tableName, "delete_by_ids");
+        nameStatement(out.existsById, tableName, "exists_by_id");
+        nameStatement(out.update, tableName, "update");
+        return out;
+    }
+    
+    static void nameStatement(StatementLayout& layout, const std::string& tableName, std::string_view kind) {
+        if (!layout.sql.empty()) {
+            layout.name = detail::statementName(tableName, kind, layout.sql);
+        }
+    }
+    
+    static std::string buildInsertColumns(bool includeAutoIncrement) {
+        constexpr const auto& table = EntityMeta<Entity>::columnTable;
+        std::string cols;
+        for (const auto& column : table.columns) {
+            if (!includeAutoIncrement && column.isAutoIncrement()) {
+                continue;
+            }
+            if (!cols.empty()) {
+                cols += ", ";
+            }
+            cols += column.columnName;
+        }
+        return cols;
+    }
+    
+    static StatementLayout buildInsert(const std::string& tableName, const std::string& cols,
+                                       bool includeAutoIncrement) {
+        constexpr const auto& table = EntityMeta<Entity>::columnTable;
+        StatementLayout layout;
+        std::string vals;
+        
+        for (int i = 0; i < static_cast<int>(table.columns.size()); ++i) {
+            if (!includeAutoIncrement && table.columns[i].isAutoIncrement()) {
+                continue;
+            }
+            if (!vals.empty()) {
+                vals += ", ";
+            }
+            layout.params.push_back(i);
+            vals += "$" + std::to_string(layout.params.size());
+        }
+        
+        layout.sql = "INSERT INTO " + tableName + " (" + cols + ") VALUES (" + vals +
+                     ") RETURNING *";
+        return layout;
+    }
+    
+    // INSERT ... VALUES with one placeholder row per entity, then tail
+    StatementLayout buildValuesInsert(std::size_t rows, bool includeAutoIncrement,
+                                      const std::string& tail, std::string_view kind) const {
+        const auto& all = statements();
+        const auto& single = insertLayout(includeAutoIncrement);
+        const std::size_t width = single.params.size();
+        
+        StatementLayout layout;
+        layout.params.reserve(rows * width);
+        layout.sql = "INSERT INTO " + all.tableName + " (" + insertColumns(includeAutoIncrement) +
+                     ") VALUES ";
+        std::size_t n = 0;
+        for (std::size_t row = 0; row < rows; ++row) {
+            layout.sql += row == 0 ? "(" : ", (";
+            for (std::size_t col = 0; col < width; ++col) {
+                if (col > 0) {
+                    layout.sql += ", ";
+                }
+                layout.sql += "$" + std::to_string(++n);
+            }
+            layout.sql += ")";
+            layout.params.insert(layout.params.end(), single.params.begin(), single.params.end());
+        }
+        layout.sql += tail;
+        nameStatement(layout, all.tableName, kind);
+        return layout;
+    }
+    
+    static std::string conflictTarget(const std::vector<int>& conflictColumns) {
+        constexpr const auto& table = EntityMeta<Entity>::columnTable;
+        std::string target;
+        for (const int index : conflictColumns) {
+            if (!target.empty()) {
+                target += ", ";
+            }
+            target += table.columns[index].columnName;
+        }
+        return target;
+    }
+    
+    static std::string conflictClause(const std::vector<int>& conflictColumns,
+                                      bool includeAutoIncrement) {
+        constexpr const auto& table = EntityMeta<Entity>::columnTable;
+        const std::string target = conflictTarget(conflictColumns);
+        
+        std::string sets;
+        for (int i = 0; i < static_cast<int>(table.columns.size()); ++i) {
+            const bool inserted = includeAutoIncrement || !table.columns[i].isAutoIncrement();
+            const bool isTarget = std::find(conflictColumns.begin(), conflictColumns.end(), i) !=
+                                  conflictColumns.end();
+            if (!inserted || isTarget) {
+                continue;
+            }
+            if (!sets.empty()) {
+                sets += ", ";
+            }
+            sets += std::string(table.columns[i].columnName) + " = EXCLUDED." +
+                    std::string(table.columns[i].columnName);
+        }
+        
+        if (sets.empty()) {
+            return " ON CONFLICT (" + target + ") DO NOTHING";
+        }
+        return " ON CONFLICT (" + target + ") DO UPDATE SET " + sets;
+    }
 };
 
 } // namespace orm
@@ -0,0 +1,97 @@
+#pragma once
+
+/**
+ * @file Page.hpp
+ * @brief Keyset pagination results and cursor tokens
+ *
+ * Keyset pagination continues after the sort key of the last row seen
+ * (WHERE (a, b) > (...)) instead of skipping rows with OFFSET, so every page
+ * costs one index range scan, however deep it is. The position is carried
+ * between requests as an opaque cursor token.
+ */
+
+#include "../core/Array.hpp"
+#include "../core/Hex.hpp"
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace pq {
+namespace orm {
+
+/**
+ * @brief Direction of a keyset page ordering (applies to every sort column)
+ */
+enum class SortOrder {
+    Ascending,
+    Descending
+};
+
+/**
+ * @brief One page of a keyset-paginated query
+ */
+template<typename Entity>
+struct Page {
+    std::vector<Entity> items;
+    std::optional<std::string> nextCursor;  // Pass to findPage() for the next page; empty on the last page
+};
+
+} // namespace orm
+
+namespace detail {
+
+/**
+ * @brief Encode sort key values as a URL-safe cursor token
+ *
+ * The token is the hex form of the values as array text, so it needs no
+ * further escaping in a query string.
+ */
+inline std::string encodePageCursor(const std::vector<std::string>& values) {
+    std::string text;
+    text.push_back('{');
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        if (i > 0) {
+            text.push_back(',');
+        }
+        appendArrayElement(text, values[i]);
+    }
+    text.push_back('}');
+    
+    std::string token(text.size() * 2, '\0');
+    hexEncode(reinterpret_cast<const unsigned char*>(text.data()), text.size(), token.data());
+    return token;
+}
+
+/**
+ * @brief Decode a cursor token from encodePageCursor()
+ * @return Sort key values, or nullopt if the token is malformed
+ */
+inline std::optional<std::vector<std::string>> decodePageCursor(const std::string& token) {
+    if (token.size() % 2 != 0) {
+        return std::nullopt;
+    }
+    std::string text(token.size() / 2, '\0');
+    if (!hexDecode(token.data(), text.size(), reinterpret_cast<unsigned char*>(text.data()))) {
+        return std::nullopt;
+    }
+    
+    std::vector<std::string> values;
+    try {
+        ArrayTextParser parser(text.c_str());
+        std::string element;
+        bool isNull = false;
+        while (parser.next(element, isNull)) {
+            if (isNull) {
+                return std::nullopt;
+            }
+            values.push_back(element);
+        }
+    } catch (const std::invalid_argument&) {
+        return std::nullopt;
+    }
+    return values;
+}
+
+} // namespace detail
+} // namespace pq
@@ -6,12 +6,28 @@
  * 
  * Provides a type-safe interface for database operations on entities.
  * Supports save, findById, findAll, update, remove operations.
+ * 
+ * CRUD statements run as named prepared statements: each connection prepares
+ * a statement the first time it runs it, so connections handed out by a pool
+ * catch up on their own. Set MapperConfig::usePreparedStatements to false to
+ * send the SQL with every call instead (e.g. behind a transaction-mode pooler).
  */
 
 #include "Entity.hpp"
+#include "EntityCache.hpp"
+#include "EntityStream.hpp"
+#include "IdentityMap.hpp"
 #include "Mapper.hpp"
+#include "Page.hpp"
+#include "../core/Array.hpp"
 #include "../core/Connection.hpp"
 #include "../core/Result.hpp"
+#include "../core/Transaction.hpp"
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <set>
+#include <unordered_map>
 #include <vector>
 #include <optional>
 
@@ -52,6 +68,19 @@ class Repository {
     EntityMapper<Entity> mapper_;
     SqlBuilder<Entity> sqlBuilder_;
     MapperConfig config_;
+    IdentityMap* identities_{nullptr};  // Shared unit-of-work cache, if any
+    StatementLayout batchInsert_;  // Full-size batch INSERT, rebuilt if batchSize changes
+    std::size_t batchInsertRows_{0};
+    
+    // Change tracking: column values of each loaded entity, by primary key text
+    using ColumnValues = detail::ChangeSnapshots::ColumnValues;
+    detail::ChangeSnapshots snapshots_;
+    std::map<std::vector<int>, StatementLayout> partialUpdates_;  // By changed column set
+    StatementLayout uncachedUpdate_;
+    static constexpr std::size_t maxPartialUpdates = 16;  // Prepared column sets per entity type
+    
+    // Protocol limit on bind parameters per statement
+    static constexpr std::size_t maxParameters = 65535;
     
 public:
     using EntityType = Entity;
@@ -66,7 +95,26 @@ public:
                         const MapperConfig& config = defaultMapperConfig())
         : conn_(conn)
         , mapper_(config)
-        , config_(config) {}
+        , config_(config)
+        , snapshots_(conn.rollbackCount()) {}
+    
+    /**
+     * @brief Construct repository sharing an identity map
+     * 
+     * findById() and findByIds() answer from the map when they can, and
+     * every entity the repository reads or writes is recorded in it.
+     * 
+     * @param identities Identity map of the unit of work (must outlive the repository);
+     *                   its connection is used
+     * @param config Optional mapper configuration
+     */
+    explicit Repository(IdentityMap& identities,
+                        const MapperConfig& config = defaultMapperConfig())
+        : conn_(identities.connection())
+        , mapper_(config)
+        , config_(config)
+        , identities_(&identities)
+        , snapshots_(conn_.rollbackCount()) {}
     
     /**
      * @brief Save a new entity to the database
@@ -74,10 +122,9 @@ public:
      * @return Saved entity with generated id, or error
      */
     [[nodiscard]] DbResult<Entity> save(const Entity& entity) {
-        auto sql = sqlBuilder_.insertSql();
         auto params = sqlBuilder_.insertParams(entity);
         
-        auto result = conn_.execute(sql, params);
+        auto result = run(sqlBuilder_.insertLayout(), params);
         
         if (!result) {
             return DbResult<Entity>::error(std::move(result).error());
@@ -88,7 +135,7 @@ public:
         }
         
         try {
-            return mapper_.mapRow((*result)[0]);
+            return loaded(mapper_.mapRow((*result)[0]));
         } catch (const MappingException& e) {
             return DbResult<Entity>::error(DbError{e.what()});
         }
@@ -96,33 +143,144 @@ public:
     
     /**
      * @brief Save multiple entities
+     * 
+     * Entities are inserted with one multi-row INSERT per MapperConfig::batchSize
+     * entities (fewer if the batch would exceed 65535 parameters). Each batch
+     * is atomic on its own; wrap the call in a Transaction to make the whole
+     * set atomic.
+     * 
      * @param entities Entities to save
-     * @return Vector of saved entities with generated ids
+     * @return Vector of saved entities with generated ids, in input order
      */
     [[nodiscard]] DbResult<std::vector<Entity>> saveAll(const std::vector<Entity>& entities) {
         std::vector<Entity> saved;
         saved.reserve(entities.size());
         
-        for (const auto& entity : entities) {
-            auto result = save(entity);
+        const std::size_t width = sqlBuilder_.insertLayout().params.size();
+        if (width == 0) {
+            // Nothing to bind: a multi-row VALUES list cannot be written
+            for (const auto& entity : entities) {
+                auto result = save(entity);
+                if (!result) {
+                    return DbResult<std::vector<Entity>>::error(std::move(result).error());
+                }
+                saved.push_back(std::move(*result));
+            }
+            return saved;
+        }
+        
+        const std::size_t chunk = std::max<std::size_t>(
+            1, std::min(config_.batchSize, maxParameters / width));
+        std::vector<std::string> params;
+        
+        for (std::size_t begin = 0; begin < entities.size(); begin += chunk) {
+            const std::size_t rows = std::min(chunk, entities.size() - begin);
+            params.clear();
+            params.reserve(rows * width);
+            for (std::size_t i = begin; i < begin + rows; ++i) {
+                sqlBuilder_.appendInsertParams(entities[i], params);
+            }
+            
+            // Only full batches are prepared, so the tail size does not leave
+            // a statement behind on the connection
+            auto result = rows == chunk
+                ? run(batchInsertLayout(chunk), params)
+                : conn_.execute(sqlBuilder_.insertBatchLayout(rows).sql, params);
+            
             if (!result) {
                 return DbResult<std::vector<Entity>>::error(std::move(result).error());
             }
-            saved.push_back(std::move(*result));
+            
+            if (static_cast<std::size_t>(result->rowCount()) != rows) {
+                return DbResult<std::vector<Entity>>::error(DbError{
+                    "Batch insert returned " + std::to_string(result->rowCount()) +
+                    " rows for " + std::to_string(rows) + " entities"});
+            }
+            
+            try {
+                const auto plan = mapper_.plan(*result);
+                for (const auto& row : *result) {
+                    saved.push_back(loaded(mapper_.mapRow(row, plan)));
+                }
+            } catch (const MappingException& e) {
+                return DbResult<std::vector<Entity>>::error(DbError{e.what()});
+            }
         }
         
         return saved;
     }
     
+    /**
+     * @brief Insert entities, updating the rows that already exist
+     * 
+     * Generates INSERT ... ON CONFLICT (conflictColumns) DO UPDATE SET
+     * col = EXCLUDED.col for every other column, MapperConfig::batchSize
+     * entities per multi-row statement. Sets of MapperConfig::copyThreshold
+     * entities or more are instead COPYed into a temporary table and merged
+     * with one INSERT ... SELECT, inside a transaction of their own unless
+     * one is already open.
+     * 
+     * Auto-increment columns are written only when they are part of
+     * conflictColumns. Of several entities with the same conflict key in one
+     * call, the last one is written (PostgreSQL cannot update a row twice in
+     * one statement).
+     * 
+     * @param entities Entities to insert or update
+     * @param conflictColumns Column names of a unique constraint; empty for the primary key
+     * @return Total number of rows inserted or updated, or error
+     */
+    [[nodiscard]] DbResult<int> upsertAll(const std::vector<Entity>& entities,
+                                          const std::vector<std::string>& conflictColumns = {}) {
+        std::vector<int> target;
+        for (const auto& name : conflictColumns) {
+            const int index = findColumnIndex<Entity>(name);
+            if (index < 0) {
+                return DbResult<int>::error(DbError{"Unknown conflict column: " + name});
+            }
+            target.push_back(index);
+        }
+        if (target.empty()) {
+            const int pk = EntityMeta<Entity>::columnTable.primaryKey;
+            if (pk < 0) {
+                return DbResult<int>::error(DbError{"Entity has no primary key"});
+            }
+            target.push_back(pk);
+        }
+        
+        if (entities.empty()) {
+            return 0;
+        }
+        
+        auto result = entities.size() >= config_.copyThreshold
+            ? upsertStaged(entities, target)
+            : upsertBatches(entities, target);
+        // The rows written are not returned, and with a unique key other than the
+        // primary key it is not known which ones they are
+        forgetAll();
+        return result;
+    }
+    
     /**
      * @brief Find an entity by its primary key
      * @param id Primary key value
      * @return Entity if found, empty optional if not found, or error
      */
     [[nodiscard]] DbResult<std::optional<Entity>> findById(const PK& id) {
-        auto sql = sqlBuilder_.selectByIdSql();
-        std::vector<std::string> params = {std::to_string(id)};
-        auto result = conn_.execute(sql, params);
+        std::vector<std::string> params = {keyText(id)};
+        if (identities_) {
+            if (const Entity* known = identities_->find<Entity>(params[0])) {
+                return std::optional<Entity>{*known};
+            }
+        }
+        EntityCache* cache = sharedCache();
+        uint64_t stamp = 0;
+        if (cache) {
+            if (auto cached = cache->get<Entity>(EntityMeta<Entity>::tableName, params[0])) {
+                return std::optional<Entity>{loaded(*cached)};
+            }
+            stamp = cache->stamp(EntityMeta<Entity>::tableName, params[0]);
+        }
+        auto result = run(sqlBuilder_.selectByIdLayout(), params);
         
         if (!result) {
             return DbResult<std::optional<Entity>>::error(std::move(result).error());
@@ -133,55 +291,264 @@ public:
         }
         
         try {
-            return std::optional<Entity>{mapper_.mapRow((*result)[0])};
+            Entity entity = loaded(mapper_.mapRow((*result)[0]));
+            if (cache) {
+                share(params[0], entity, stamp);
+            }
+            return std::optional<Entity>{std::move(entity)};
         } catch (const MappingException& e) {
             return DbResult<std::optional<Entity>>::error(DbError{e.what()});
         }
     }
     
+    /**
+     * @brief Find entities by a list of primary keys
+     * 
+     * Runs SELECT ... WHERE pk = ANY($1), one query per MapperConfig::batchSize
+     * distinct keys. Repeated keys are looked up once and keys with no row
+     * are skipped. A row whose key the server spells differently (char(n)
+     * padding, citext case) is found only when it is the one such row in its
+     * batch.
+     * 
+     * @param ids Primary key values
+     * @return Entities found, in the order their keys first appear in ids
+     */
+    [[nodiscard]] DbResult<std::vector<Entity>> findByIds(const std::vector<PK>& ids) {
+        std::vector<const PK*> uniqueIds;
+        std::vector<std::optional<Entity>> found;
+        auto fetched = fetchByIds(ids, uniqueIds, found);
+        if (!fetched) {
+            return DbResult<std::vector<Entity>>::error(std::move(fetched).error());
+        }
+        
+        std::vector<Entity> entities;
+        entities.reserve(found.size());
+        for (auto& entity : found) {
+            if (entity) {
+                entities.push_back(std::move(*entity));
+            }
+        }
+        return entities;
+    }
+    
+    /**
+     * @brief Find entities by a list of primary keys, keyed by primary key
+     * 
+     * Same query as findByIds(); keys with no row have no entry.
+     */
+    [[nodiscard]] DbResult<std::unordered_map<PK, Entity>> findByIdsAsMap(
+            const std::vector<PK>& ids) {
+        std::vector<const PK*> uniqueIds;
+        std::vector<std::optional<Entity>> found;
+        auto fetched = fetchByIds(ids, uniqueIds, found);
+        if (!fetched) {
+            return DbResult<std::unordered_map<PK, Entity>>::error(std::move(fetched).error());
+        }
+        
+        std::unordered_map<PK, Entity> entities;
+        entities.reserve(found.size());
+        for (std::size_t i = 0; i < found.size(); ++i) {
+            if (found[i]) {
+                entities.emplace(*uniqueIds[i], std::move(*found[i]));
+            }
+        }
+        return entities;
+    }
+    
     /**
      * @brief Find all entities
      * @return Vector of all entities
      */
     [[nodiscard]] DbResult<std::vector<Entity>> findAll() {
-        auto sql = sqlBuilder_.selectAllSql();
-        auto result = conn_.execute(sql);
+        auto result = run(sqlBuilder_.selectAllLayout(), {});
         
         if (!result) {
             return DbResult<std::vector<Entity>>::error(std::move(result).error());
         }
         
         try {
-            return mapper_.mapAll(*result);
+            return loadedAll(mapper_.mapAll(*result));
         } catch (const MappingException& e) {
             return DbResult<std::vector<Entity>>::error(DbError{e.what()});
         }
     }
     
     /**
-     * @brief Update an existing entity
-     * @param entity Entity to update (must have valid primary key)
-     * @return Updated entity, or error
+     * @brief Fetch one page with keyset pagination
+     * 
+     * Rows are ordered by orderBy, with the primary key appended as a tie
+     * breaker, and the page starts after the position encoded in afterCursor.
+     * Each page is one index range scan, however deep, unlike LIMIT/OFFSET.
+     * 
+     * @code
+     * auto page = userRepo.findPage("", 50, {"created_at"});
+     * while (page && page->nextCursor) {
+     *     page = userRepo.findPage(*page->nextCursor, 50, {"created_at"});
+     * }
+     * @endcode
+     * 
+     * @param afterCursor nextCursor of the previous page, or empty for the first page
+     * @param limit Maximum number of entities on the page
+     * @param orderBy Sort column names (NOT NULL columns); empty for the primary key
+     * @param order Direction applied to every sort column
+     * @return Page whose nextCursor is set if more rows follow
      */
-    [[nodiscard]] DbResult<Entity> update(const Entity& entity) {
-        auto sql = sqlBuilder_.updateSql();
-        auto params = sqlBuilder_.updateParams(entity);
+    [[nodiscard]] DbResult<Page<Entity>> findPage(const std::string& afterCursor,
+                                                  std::size_t limit,
+                                                  const std::vector<std::string>& orderBy = {},
+                                                  SortOrder order = SortOrder::Ascending) {
+        if (limit == 0) {
+            return DbResult<Page<Entity>>::error(DbError{"Page limit must be positive"});
+        }
         
-        auto result = conn_.execute(sql, params);
+        std::vector<int> columns;
+        for (const auto& name : orderBy) {
+            const int index = findColumnIndex<Entity>(name);
+            if (index < 0) {
+                return DbResult<Page<Entity>>::error(DbError{"Unknown sort column: " + name});
+            }
+            columns.push_back(index);
+        }
+        const int pk = EntityMeta<Entity>::columnTable.primaryKey;
+        if (pk >= 0 && std::find(columns.begin(), columns.end(), pk) == columns.end()) {
+            columns.push_back(pk);
+        }
+        if (columns.empty()) {
+            return DbResult<Page<Entity>>::error(DbError{"Entity has no primary key"});
+        }
         
-        if (!result) {
-            return DbResult<Entity>::error(std::move(result).error());
+        std::vector<std::string> params;
+        if (!afterCursor.empty()) {
+            auto values = detail::decodePageCursor(afterCursor);
+            if (!values || values->size() != columns.size()) {
+                return DbResult<Page<Entity>>::error(DbError{"Invalid page cursor"});
+            }
+            params = std::move(*values);
         }
+        // One row beyond the page tells whether another page follows
+        params.push_back(std::to_string(limit + 1));
         
-        if (result->empty()) {
-            return DbResult<Entity>::error(DbError{"Entity not found for update"});
+        auto result = run(sqlBuilder_.pageLayout(columns, !afterCursor.empty(), order), params);
+        if (!result) {
+            return DbResult<Page<Entity>>::error(std::move(result).error());
         }
         
+        Page<Entity> page;
         try {
-            return mapper_.mapRow((*result)[0]);
+            page.items = loadedAll(mapper_.mapAll(*result));
         } catch (const MappingException& e) {
-            return DbResult<Entity>::error(DbError{e.what()});
+            return DbResult<Page<Entity>>::error(DbError{e.what()});
+        }
+        
+        if (page.items.size() > limit) {
+            page.items.resize(limit);
+            std::vector<std::string> last;
+            for (const int column : columns) {
+                auto value = sqlBuilder_.columnValue(page.items.back(), column);
+                if (!value) {
+                    return DbResult<Page<Entity>>::error(
+                        DbError{"Keyset pagination requires non-null sort columns"});
+                }
+                last.push_back(std::move(*value));
+            }
+            page.nextCursor = detail::encodePageCursor(last);
+        }
+        return page;
+    }
+    
+    /**
+     * @brief Stream all entities at constant memory
+     * 
+     * The query runs in single-row mode and each row is mapped as it is
+     * reached (see EntityStream). The connection cannot run other queries
+     * until the stream has been read to the end or closed.
+     */
+    [[nodiscard]] DbResult<EntityStream<Entity>> stream() {
+        return stream(sqlBuilder_.selectAllSql());
+    }
+    
+    /**
+     * @brief Stream the entities of a custom query at constant memory
+     */
+    [[nodiscard]] DbResult<EntityStream<Entity>> stream(
+            std::string_view sql,
+            const std::vector<std::string>& params = {}) {
+        auto rows = core::RowStream::open(conn_, sql, params);
+        if (!rows) {
+            return DbResult<EntityStream<Entity>>::error(std::move(rows).error());
+        }
+        return EntityStream<Entity>(std::move(*rows), config_);
+    }
+    
+    /**
+     * @brief Process all entities in batches at constant memory
+     * 
+     * Streams like stream(); each batch is handed to fn before the next row
+     * is read, so at most batchSize entities are held at a time.
+     * 
+     * @param fn Called with each batch as std::vector<Entity>&; it may move
+     *           entities out, as the batch is cleared afterwards
+     * @param batchSize Entities per call
+     */
+    template<typename Fn>
+    [[nodiscard]] DbResult<void> forEach(Fn&& fn, std::size_t batchSize = 1000) {
+        auto entities = stream();
+        if (!entities) {
+            return DbResult<void>::error(std::move(entities).error());
+        }
+        
+        batchSize = std::max<std::size_t>(1, batchSize);
+        std::vector<Entity> batch;
+        batch.reserve(batchSize);
+        while (auto entity = entities->next()) {
+            batch.push_back(std::move(*entity));
+            if (batch.size() == batchSize) {
+                fn(batch);
+                batch.clear();
+            }
+        }
+        
+        if (entities->error()) {
+            return DbResult<void>::error(*entities->error());
+        }
+        if (!batch.empty()) {
+            fn(batch);
+        }
+        return DbResult<void>::ok();
+    }
+    
+    /**
+     * @brief Update an existing entity
+     * 
+     * With MapperConfig::trackChanges, an entity this repository loaded is
+     * compared with its snapshot from that load: only the changed columns are
+     * written, and nothing is sent at all when none changed. Snapshots are
+     * dropped after a rollback on the connection.
+     * 
+     * @param entity Entity to update (must have valid primary key)
+     * @return Updated entity, or error
+     */
+    [[nodiscard]] DbResult<Entity> update(const Entity& entity) {
+        if (config_.trackChanges) {
+            // A rollback since the load may have undone the row it was taken from
+            const ColumnValues* snapshot =
+                snapshots_.find(sqlBuilder_.primaryKeyValue(entity), conn_.rollbackCount());
+            if (snapshot) {
+                return updateChanged(entity, *snapshot);
+            }
         }
+        
+        auto params = sqlBuilder_.updateParams(entity);
+        return updateWith(sqlBuilder_.updateLayout(), params);
+    }
+    
+    /**
+     * @brief Drop every change-tracking snapshot
+     * 
+     * Later updates of entities loaded before the call write every column.
+     */
+    void clearSnapshots() noexcept {
+        snapshots_.clear();
     }
     
     /**
@@ -190,12 +557,12 @@ public:
      * @return Number of rows affected, or error
      */
     [[nodiscard]] DbResult<int> removeById(const PK& id) {
-        auto sql = sqlBuilder_.deleteSql();
-        std::vector<std::string> params = {std::to_string(id)};
-        auto result = conn_.execute(sql, params);
+        std::vector<std::string> params = {keyText(id)};
+        auto result = run(sqlBuilder_.deleteLayout(), params);
         if (!result) {
             return DbResult<int>::error(std::move(result).error());
         }
+        forget(params[0]);
         return result->affectedRows();
     }
     
@@ -206,32 +573,49 @@ public:
      */
     [[nodiscard]] DbResult<int> remove(const Entity& entity) {
         auto pkValue = sqlBuilder_.primaryKeyValue(entity);
-        auto sql = sqlBuilder_.deleteSql();
         std::vector<std::string> params = {pkValue};
-        auto result = conn_.execute(sql, params);
+        auto result = run(sqlBuilder_.deleteLayout(), params);
         if (!result) {
             return DbResult<int>::error(std::move(result).error());
         }
+        forget(pkValue);
         return result->affectedRows();
     }
     
+    /**
+     * @brief Remove entities by primary key
+     * 
+     * Runs DELETE ... WHERE pk = ANY($1) with one key array per
+     * MapperConfig::batchSize keys. Batches already run stay deleted if a
+     * later one fails, unless the call is wrapped in a Transaction.
+     * 
+     * @param ids Primary keys of entities to remove
+     * @return Total number of rows affected, or error
+     */
+    [[nodiscard]] DbResult<int> removeByIds(const std::vector<PK>& ids) {
+        std::vector<std::string> keys;
+        keys.reserve(ids.size());
+        for (const auto& id : ids) {
+            keys.push_back(keyText(id));
+        }
+        return removeKeys(keys);
+    }
+    
     /**
      * @brief Remove multiple entities
-     * @param entities Entities to remove
+     * 
+     * Set-based like removeByIds().
+     * 
+     * @param entities Entities to remove (uses primary key)
      * @return Total number of rows affected
      */
     [[nodiscard]] DbResult<int> removeAll(const std::vector<Entity>& entities) {
-        int totalAffected = 0;
-        
+        std::vector<std::string> keys;
+        keys.reserve(entities.size());
         for (const auto& entity : entities) {
-            auto result = remove(entity);
-            if (!result) {
-                return DbResult<int>::error(std::move(result).error());
-            }
-            totalAffected += *result;
+            keys.push_back(sqlBuilder_.primaryKeyValue(entity));
         }
-        
-        return totalAffected;
+        return removeKeys(keys);
     }
     
     /**
@@ -239,8 +623,7 @@ public:
      * @return Total count
      */
     [[nodiscard]] DbResult<int64_t> count() {
-        auto sql = "SELECT COUNT(*) FROM " + std::string(sqlBuilder_.metadata().tableName());
-        auto result = conn_.execute(sql);
+        auto result = run(sqlBuilder_.countLayout(), {});
         
         if (!result) {
             return DbResult<int64_t>::error(std::move(result).error());
@@ -258,17 +641,12 @@ public:
      * @param id Primary key to check
      */
     [[nodiscard]] DbResult<bool> existsById(const PK& id) {
-        const auto& meta = sqlBuilder_.metadata();
-        const auto* pk = meta.primaryKey();
-        if (!pk) {
+        if (!sqlBuilder_.metadata().primaryKey()) {
             return DbResult<bool>::error(DbError{"Entity has no primary key"});
         }
         
-        auto sql = "SELECT 1 FROM " + std::string(meta.tableName()) +
-                   " WHERE " + std::string(pk->info.columnName) + " = $1 LIMIT 1";
-        
-        std::vector<std::string> params = {std::to_string(id)};
-        auto result = conn_.execute(sql, params);
+        std::vector<std::string> params = {keyText(id)};
+        auto result = run(sqlBuilder_.existsByIdLayout(), params);
         
         if (!result) {
             return DbResult<bool>::error(std::move(result).error());
@@ -331,6 +709,444 @@ public:
     [[nodiscard]] MapperConfig& config() noexcept {
         return config_;
     }
+
+private:
+    DbResult<Entity> updateChanged(const Entity& entity, const ColumnValues& snapshot) {
+        const int pk = EntityMeta<Entity>::columnTable.primaryKey;
+        ColumnValues current = sqlBuilder_.columnValues(entity);
+        std::vector<int> changed;
+        for (int i = 0; i < static_cast<int>(current.size()); ++i) {
+            if (i != pk && current[i] != snapshot[i]) {
+                changed.push_back(i);
+            }
+        }
+        if (changed.empty()) {
+            return entity;
+        }
+        
+        const StatementLayout& statement = partialUpdateLayout(changed);
+        std::vector<std::string> params;
+        params.reserve(statement.params.size());
+        for (const int column : statement.params) {
+            // Empty parameter means NULL, as in updateParams()
+            params.push_back(current[column].value_or(std::string()));
+        }
+        // Column sets past the cache are not prepared either
+        return updateWith(statement, params, &statement != &uncachedUpdate_);
+    }
+    
+    DbResult<Entity> updateWith(const StatementLayout& statement,
+                                const std::vector<std::string>& params,
+                                bool prepared = true) {
+        auto result = prepared ? run(statement, params) : conn_.execute(statement.sql, params);
+        
+        if (!result) {
+            return DbResult<Entity>::error(std::move(result).error());
+        }
+        
+        if (result->empty()) {
+            return DbResult<Entity>::error(DbError{"Entity not found for update"});
+        }
+        
+        try {
+            Entity entity = loaded(mapper_.mapRow((*result)[0]));
+            unshare(sqlBuilder_.primaryKeyValue(entity));
+            return entity;
+        } catch (const MappingException& e) {
+            return DbResult<Entity>::error(DbError{e.what()});
+        }
+    }
+    
+    const StatementLayout& partialUpdateLayout(const std::vector<int>& columns) {
+        auto it = partialUpdates_.find(columns);
+        if (it != partialUpdates_.end()) {
+            return it->second;
+        }
+        if (!admitPartialUpdate(columns)) {
+            // Column sets past the bound: built each time and run unprepared
+            uncachedUpdate_ = sqlBuilder_.updateLayout(columns);
+            return uncachedUpdate_;
+        }
+        return partialUpdates_.emplace(columns, sqlBuilder_.updateLayout(columns)).first->second;
+    }
+    
+    // Repositories are short-lived but connections are pooled, and every
+    // prepared column set stays on each connection that ran it. The first
+    // maxPartialUpdates column sets of the entity type, over all repositories,
+    // are the only ones prepared.
+    static bool admitPartialUpdate(const std::vector<int>& columns) {
+        static std::mutex mutex;
+        static std::set<std::vector<int>> admitted;
+        
+        std::lock_guard<std::mutex> lock(mutex);
+        if (admitted.count(columns) != 0) {
+            return true;
+        }
+        if (admitted.size() >= maxPartialUpdates) {
+            return false;
+        }
+        admitted.insert(columns);
+        return true;
+    }
+    
+    DbResult<core::QueryResult> run(const StatementLayout& statement,
+                                    const std::vector<std::string>& params) {
+        if (config_.usePreparedStatements) {
+            return conn_.executeStatement(statement.name, statement.sql, params);
+        }
+        return conn_.execute(statement.sql, params);
+    }
+    
+    // Every entity read or written through the repository passes through here
+    void track(const Entity& entity) {
+        if (EntityMeta<Entity>::columnTable.primaryKey < 0 || (!config_.trackChanges && !identities_)) {
+            return;
+        }
+        std::string key = sqlBuilder_.primaryKeyValue(entity);
+        if (identities_) {
+            identities_->put(key, entity);
+        }
+        if (config_.trackChanges) {
+            snapshots_.put(std::move(key), sqlBuilder_.columnValues(entity), conn_.rollbackCount());
+        }
+    }
+    
+    Entity loaded(Entity entity) {
+        track(entity);
+        return entity;
+    }
+    
+    std::vector<Entity> loadedAll(std::vector<Entity> entities) {
+        for (const auto& entity : entities) {
+            track(entity);
+        }
+        return entities;
+    }
+    
+    // Called with the primary key text of each removed row
+    void forget(const std::string& key) {
+        snapshots_.erase(key);
+        if (identities_) {
+            identities_->erase<Entity>(key);
+        }
+        unshare(key);
+    }
+    
+    // After writes whose rows are not known
+    void forgetAll() {
+        snapshots_.clear();
+        if (identities_) {
+            identities_->evict<Entity>();
+        }
+        // As in unshare()
+        if (EntityCache* cache = config_.entityCache) {
+            cache->invalidateTable(EntityMeta<Entity>::tableName);
+            if (conn_.inTransaction()) {
+                conn_.afterCommit([cache] {
+                    cache->invalidateTable(EntityMeta<Entity>::tableName);
+                });
+            }
+        }
+    }
+    
+    // Drop a written row from the shared cache. Inside a transaction, a reader on
+    // another connection can refill it with the old committed row until COMMIT,
+    // so it is dropped again once the write is visible.
+    void unshare(const std::string& key) {
+        EntityCache* cache = config_.entityCache;
+        if (!cache) {
+            return;
+        }
+        cache->invalidate(EntityMeta<Entity>::tableName, key);
+        if (conn_.inTransaction()) {
+            conn_.afterCommit([cache, key] {
+                cache->invalidate(EntityMeta<Entity>::tableName, key);
+            });
+        }
+    }
+    
+    // Inside a transaction rows may be uncommitted, or about to be rolled back
+    EntityCache* sharedCache() const noexcept {
+        return conn_.inTransaction() ? nullptr : config_.entityCache;
+    }
+    
+    // Fill the shared cache with a row read after stamp was taken. It is stored
+    // only when the row reads back under the key it was looked up by:
+    // notifications carry the server's text of the key, and one spelled
+    // differently (char(n) padding, citext case) would never invalidate it.
+    void share(const std::string& key, const Entity& entity, uint64_t stamp) {
+        if (sqlBuilder_.primaryKeyValue(entity) != key) {
+            return;
+        }
+        std::size_t bytes = sizeof(Entity);
+        for (const auto& value : sqlBuilder_.columnValues(entity)) {
+            bytes += value ? value->size() : 0;
+        }
+        sharedCache()->put(EntityMeta<Entity>::tableName, key, entity, bytes, stamp);
+    }
+    
+    static std::string keyText(const PK& id) {
+        return PgTypeTraits<PK>::toString(id);
+    }
+    
+    // Array literal of keys[begin, end) for a pk = ANY($1) parameter
+    static std::string keyArray(const std::vector<std::string>& keys,
+                                std::size_t begin, std::size_t end) {
+        std::string out;
+        out.push_back('{');
+        for (std::size_t i = begin; i < end; ++i) {
+            if (i > begin) {
+                out.push_back(',');
+            }
+            detail::appendArrayElement(out, keys[i]);
+        }
+        out.push_back('}');
+        return out;
+    }
+    
+    // Looks up the distinct ids; found[i] holds the entity of *uniqueIds[i], if any.
+    // Rows are matched back to ids by detail::matchRowKeys().
+    DbResult<void> fetchByIds(const std::vector<PK>& ids,
+                              std::vector<const PK*>& uniqueIds,
+                              std::vector<std::optional<Entity>>& found) {
+        std::vector<std::string> texts;
+        texts.reserve(ids.size());
+        for (const auto& id : ids) {
+            texts.push_back(keyText(id));
+        }
+        
+        std::vector<std::string> keys;
+        std::unordered_map<std::string, std::size_t> positions;
+        for (std::size_t i : detail::distinctKeys(texts)) {
+            positions.emplace(texts[i], keys.size());
+            keys.push_back(std::move(texts[i]));
+            uniqueIds.push_back(&ids[i]);
+        }
+        found.assign(keys.size(), std::nullopt);
+        
+        // Only keys missing from the identity map are queried
+        if (identities_) {
+            std::vector<std::string> missing;
+            for (std::size_t i = 0; i < keys.size(); ++i) {
+                if (const Entity* known = identities_->find<Entity>(keys[i])) {
+                    found[i] = *known;
+                } else {
+                    missing.push_back(std::move(keys[i]));
+                }
+            }
+            keys = std::move(missing);
+        }
+        
+        // Then those missing from the shared cache
+        EntityCache* cache = sharedCache();
+        std::vector<uint64_t> stamps;
+        if (cache) {
+            std::vector<std::string> missing;
+            stamps.resize(found.size());
+            for (auto& key : keys) {
+                const std::size_t position = positions[key];
+                if (auto cached = cache->get<Entity>(EntityMeta<Entity>::tableName, key)) {
+                    found[position] = loaded(*cached);
+                } else {
+                    stamps[position] = cache->stamp(EntityMeta<Entity>::tableName, key);
+                    missing.push_back(std::move(key));
+                }
+            }
+            keys = std::move(missing);
+        }
+        if (keys.empty()) {
+            return DbResult<void>::ok();
+        }
+        
+        const auto& statement = sqlBuilder_.selectByIdsLayout();
+        const std::size_t chunk = std::max<std::size_t>(1, config_.batchSize);
+        
+        for (std::size_t begin = 0; begin < keys.size(); begin += chunk) {
+            const std::size_t end = std::min(keys.size(), begin + chunk);
+            auto result = run(statement, {keyArray(keys, begin, end)});
+            if (!result) {
+                return DbResult<void>::error(std::move(result).error());
+            }
+            
+            try {
+                auto entities = mapper_.mapAll(*result);
+                std::vector<std::string> rowKeys;
+                rowKeys.reserve(entities.size());
+                for (const auto& entity : entities) {
+                    rowKeys.push_back(sqlBuilder_.primaryKeyValue(entity));
+                }
+                
+                const auto matches = detail::matchRowKeys(keys, begin, end, rowKeys);
+                for (std::size_t row = 0; row < entities.size(); ++row) {
+                    if (!matches[row]) {
+                        continue;
+                    }
+                    const std::string& key = keys[*matches[row]];
+                    const std::size_t position = positions[key];
+                    Entity entity = loaded(std::move(entities[row]));
+                    if (cache) {
+                        share(key, entity, stamps[position]);
+                    }
+                    found[position] = std::move(entity);
+                }
+            } catch (const MappingException& e) {
+                return DbResult<void>::error(DbError{e.what()});
+            }
+        }
+        
+        return DbResult<void>::ok();
+    }
+    
+    // Position of the last entity of each conflict key; a NULL in the key conflicts with nothing
+    std::vector<std::size_t> lastPerConflictKey(const std::vector<Entity>& entities,
+                                                const std::vector<int>& target) const {
+        std::vector<std::optional<std::string>> keys;
+        keys.reserve(entities.size());
+        for (const auto& entity : entities) {
+            const auto values = sqlBuilder_.columnValues(entity);
+            std::optional<std::string> key(std::in_place);
+            for (const int index : target) {
+                if (!values[index]) {
+                    key.reset();
+                    break;
+                }
+                // Length-prefixed, so column boundaries cannot shift
+                *key += std::to_string(values[index]->size());
+                key->push_back(':');
+                *key += *values[index];
+            }
+            keys.push_back(std::move(key));
+        }
+        return detail::lastPerKey(keys);
+    }
+    
+    DbResult<int> upsertBatches(const std::vector<Entity>& all, const std::vector<int>& target) {
+        const auto kept = lastPerConflictKey(all, target);
+        const bool includeAutoIncrement = SqlBuilder<Entity>::includesAutoIncrement(target);
+        const std::size_t width = sqlBuilder_.insertLayout(includeAutoIncrement).params.size();
+        const std::size_t chunk = std::max<std::size_t>(
+            1, std::min(config_.batchSize, maxParameters / std::max<std::size_t>(1, width)));
+        std::vector<std::string> params;
+        StatementLayout full;
+        int totalAffected = 0;
+        
+        for (std::size_t begin = 0; begin < kept.size(); begin += chunk) {
+            const std::size_t rows = std::min(chunk, kept.size() - begin);
+            params.clear();
+            params.reserve(rows * width);
+            for (std::size_t i = begin; i < begin + rows; ++i) {
+                sqlBuilder_.appendInsertParams(all[kept[i]], params, includeAutoIncrement);
+            }
+            
+            // As in saveAll(), only full batches are prepared
+            if (rows == chunk && full.sql.empty()) {
+                full = sqlBuilder_.upsertLayout(chunk, target);
+            }
+            auto result = rows == chunk
+                ? run(full, params)
+                : conn_.execute(sqlBuilder_.upsertLayout(rows, target).sql, params);
+            
+            if (!result) {
+                return DbResult<int>::error(std::move(result).error());
+            }
+            totalAffected += result->affectedRows();
+        }
+        
+        return totalAffected;
+    }
+    
+    // COPY into a temporary table, then merge with one INSERT ... SELECT ... ON CONFLICT.
+    // Each row carries its position in entities, so the last of a conflict key wins.
+    DbResult<int> upsertStaged(const std::vector<Entity>& entities, const std::vector<int>& target) {
+        std::optional<core::Transaction> tx;
+        if (!conn_.inTransaction()) {
+            tx.emplace(conn_);
+            if (!*tx) {
+                return DbResult<int>::error(DbError{"upsertAll: could not begin transaction"});
+            }
+        }
+        
+        const bool includeAutoIncrement = SqlBuilder<Entity>::includesAutoIncrement(target);
+        const std::string& cols = sqlBuilder_.insertColumns(includeAutoIncrement);
+        const std::string stage = detail::statementName(
+            EntityMeta<Entity>::tableName, "stage", cols);
+        
+        constexpr const char* ordinal = "pq_ordinal";
+        auto created = conn_.execute("CREATE TEMP TABLE " + stage + " ON COMMIT DROP AS SELECT " +
+                                     cols + ", 0::bigint AS " + ordinal + " FROM " +
+                                     std::string(EntityMeta<Entity>::tableName) + " WITH NO DATA");
+        if (!created) {
+            return DbResult<int>::error(std::move(created).error());
+        }
+        
+        std::string data;
+        char ordinalText[PgTypeTraits<int64_t>::maxTextLength];
+        for (std::size_t row = 0; row < entities.size(); ++row) {
+            sqlBuilder_.appendCopyFields(entities[row], data, includeAutoIncrement);
+            data.push_back('\t');
+            data.append(ordinalText, PgTypeTraits<int64_t>::formatTo(
+                static_cast<int64_t>(row), ordinalText, sizeof(ordinalText)));
+            data.push_back('\n');
+        }
+        
+        auto copied = conn_.copyIn("COPY " + stage + " (" + cols + ", " + ordinal + ") FROM STDIN",
+                                   data);
+        if (!copied) {
+            return DbResult<int>::error(std::move(copied).error());
+        }
+        
+        auto merged = conn_.execute(sqlBuilder_.upsertFromSql(stage, target, ordinal));
+        if (!merged) {
+            return DbResult<int>::error(std::move(merged).error());
+        }
+        const int affected = merged->affectedRows();
+        
+        // Inside a caller's transaction ON COMMIT DROP would come too late for a second call
+        auto dropped = conn_.execute("DROP TABLE " + stage);
+        if (!dropped) {
+            return DbResult<int>::error(std::move(dropped).error());
+        }
+        
+        if (tx) {
+            auto committed = tx->commit();
+            if (!committed) {
+                return DbResult<int>::error(std::move(committed).error());
+            }
+        }
+        return affected;
+    }
+    
+    DbResult<int> removeKeys(const std::vector<std::string>& keys) {
+        if (keys.empty()) {
+            return 0;
+        }
+        
+        const auto& statement = sqlBuilder_.deleteByIdsLayout();
+        const std::size_t chunk = std::max<std::size_t>(1, config_.batchSize);
+        int totalAffected = 0;
+        
+        for (std::size_t begin = 0; begin < keys.size(); begin += chunk) {
+            const std::size_t end = std::min(keys.size(), begin + chunk);
+            auto result = run(statement, {keyArray(keys, begin, end)});
+            if (!result) {
+                return DbResult<int>::error(std::move(result).error());
+            }
+            for (std::size_t i = begin; i < end; ++i) {
+                forget(keys[i]);
+            }
+            totalAffected += result->affectedRows();
+        }
+        
+        return totalAffected;
+    }
+    
+    const StatementLayout& batchInsertLayout(std::size_t rows) {
+        if (batchInsertRows_ != rows) {
+            batchInsert_ = sqlBuilder_.insertBatchLayout(rows);
+            batchInsertRows_ = rows;
+        }
+        return batchInsert_;
+    }
 };
 
 } // namespace orm
@@ -15,14 +15,28 @@
 #include "core/PqHandle.hpp"
 #include "core/Result.hpp"
 #include "core/Types.hpp"
+#include "core/Decimal.hpp"
+#include "core/Uuid.hpp"
+#include "core/Array.hpp"
+#include "core/Bytea.hpp"
+#include "core/Jsonb.hpp"
+#include "core/Enum.hpp"
+#include "core/FixedString.hpp"
+#include "core/Record.hpp"
 #include "core/QueryResult.hpp"
 #include "core/Connection.hpp"
 #include "core/Transaction.hpp"
+#include "core/RowStream.hpp"
+#include "core/TypeRegistry.hpp"
 #include "core/ConnectionPool.hpp"
 
 // ORM components
 #include "orm/Entity.hpp"
 #include "orm/Mapper.hpp"
+#include "orm/EntityStream.hpp"
+#include "orm/Page.hpp"
+#include "orm/IdentityMap.hpp"
+#include "orm/EntityCache.hpp"
 #include "orm/Repository.hpp"
 
 /**
@@ -38,11 +52,18 @@ using core::QueryResult;
 using core::Row;
 using core::Transaction;
 using core::Savepoint;
+using core::Notification;
+using core::RowStream;
 using core::ConnectionPool;
 using core::PooledConnection;
 using core::PoolConfig;
+using core::TypeRegistry;
+using core::PgTypeInfo;
 
 using orm::Repository;
+using orm::IdentityMap;
+using orm::EntityCache;
+using orm::EntityCacheConfig;
 using orm::MapperConfig;
 using orm::ColumnFlags;
 
@@ -0,0 +1,219 @@
+/**
+ * @file Array.cpp
+ * @brief Implementation of the array text and binary codecs
+ */
+
+#include "pq/core/Array.hpp"
+#include <stdexcept>
+
+namespace pq {
+namespace detail {
+
+namespace {
+
+constexpr std::size_t kArrayHeaderSize = 12;     // ndim, flags, element OID
+constexpr std::size_t kArrayDimensionSize = 8;   // size, lower bound
+
+inline bool isArraySpace(char c) noexcept {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+}
+
+inline bool equalsNullKeyword(std::string_view value) noexcept {
+    return value.size() == 4 &&
+           (value[0] | 0x20) == 'n' && (value[1] | 0x20) == 'u' &&
+           (value[2] | 0x20) == 'l' && (value[3] | 0x20) == 'l';
+}
+
+inline bool needsQuoting(std::string_view value) noexcept {
+    if (value.empty() || equalsNullKeyword(value)) {
+        return true;
+    }
+    for (char c : value) {
+        if (c == '{' || c == '}' || c == ',' || c == '"' || c == '\\' || isArraySpace(c)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+// ----------------------------------------------------------------------------
+// Text format
+// ----------------------------------------------------------------------------
+
+void appendArrayElement(std::string& out, std::string_view value) {
+    if (!needsQuoting(value)) {
+        out.append(value);
+        return;
+    }
+    out.push_back('"');
+    for (char c : value) {
+        if (c == '"' || c == '\\') {
+            out.push_back('\\');
+        }
+        out.push_back(c);
+    }
+    out.push_back('"');
+}
+
+ArrayTextParser::ArrayTextParser(const char* text)
+    : pos_(text ? text : "")
+    , text_(pos_) {
+    while (isArraySpace(*pos_)) ++pos_;
+    
+    // Optional dimension decoration, e.g. "[0:2]={1,2,3}"
+    if (*pos_ == '[') {
+        while (*pos_ && *pos_ != '=') ++pos_;
+        if (*pos_ != '=') fail("unterminated dimension decoration");
+        ++pos_;
+        while (isArraySpace(*pos_)) ++pos_;
+    }
+    
+    if (*pos_ != '{') fail("array value must start with \"{\"");
+    ++pos_;
+    while (isArraySpace(*pos_)) ++pos_;
+    
+    if (*pos_ == '{') fail("multidimensional arrays are not supported");
+    if (*pos_ == '}') {
+        ++pos_;
+        done_ = true;
+    }
+}
+
+bool ArrayTextParser::next(std::string& element, bool& isNull) {
+    if (done_) {
+        return false;
+    }
+    
+    element.clear();
+    isNull = false;
+    while (isArraySpace(*pos_)) ++pos_;
+    
+    if (*pos_ == '"') {
+        ++pos_;
+        while (*pos_ != '"') {
+            if (*pos_ == '\0') fail("unterminated quoted element");
+            if (*pos_ == '\\') {
+                ++pos_;
+                if (*pos_ == '\0') fail("unexpected end of input");
+            }
+            element.push_back(*pos_++);
+        }
+        ++pos_;
+        while (isArraySpace(*pos_)) ++pos_;
+    } else {
+        // Unquoted: trailing whitespace is not part of the value, but
+        // backslash-escaped whitespace is
+        std::size_t keep = 0;
+        bool escaped = false;
+        while (*pos_ != ',' && *pos_ != '}') {
+            if (*pos_ == '\0') fail("unexpected end of input");
+            if (*pos_ == '{' || *pos_ == '"') fail("unexpected character");
+            if (*pos_ == '\\') {
+                ++pos_;
+                if (*pos_ == '\0') fail("unexpected end of input");
+                escaped = true;
+                element.push_back(*pos_++);
+                keep = element.size();
+                continue;
+            }
+            element.push_back(*pos_);
+            if (!isArraySpace(*pos_)) {
+                keep = element.size();
+            }
+            ++pos_;
+        }
+        element.resize(keep);
+        if (element.empty()) fail("empty element");
+        isNull = !escaped && equalsNullKeyword(element);
+    }
+    
+    if (*pos_ == ',') {
+        ++pos_;
+    } else if (*pos_ == '}') {
+        ++pos_;
+        while (isArraySpace(*pos_)) ++pos_;
+        if (*pos_ != '\0') fail("junk after closing \"}\"");
+        done_ = true;
+    } else {
+        fail("expected \",\" or \"}\"");
+    }
+    return true;
+}
+
+void ArrayTextParser::fail(const char* reason) const {
+    throw std::invalid_argument(
+        std::string("Malformed array literal \"") + text_ + "\": " + reason);
+}
+
+// ----------------------------------------------------------------------------
+// Binary format
+// ----------------------------------------------------------------------------
+
+ArrayBinaryReader::ArrayBinaryReader(const char* data, int length)
+    : pos_(data)
+    , end_(data + (length > 0 ? length : 0)) {
+    if (static_cast<std::size_t>(end_ - pos_) < kArrayHeaderSize) {
+        throw std::runtime_error("Invalid binary array: truncated header");
+    }
+    
+    const auto ndim = static_cast<int32_t>(readBE32(pos_));
+    pos_ += kArrayHeaderSize;
+    if (ndim == 0) {
+        return;
+    }
+    if (ndim != 1) {
+        throw std::runtime_error("Multidimensional arrays are not supported");
+    }
+    if (static_cast<std::size_t>(end_ - pos_) < kArrayDimensionSize) {
+        throw std::runtime_error("Invalid binary array: truncated dimensions");
+    }
+    
+    count_ = static_cast<int32_t>(readBE32(pos_));
+    pos_ += kArrayDimensionSize;
+    
+    // Every element carries at least its 4-byte length word
+    if (count_ < 0 || static_cast<std::size_t>(count_) > static_cast<std::size_t>(end_ - pos_) / 4) {
+        throw std::runtime_error("Invalid binary array: bad element count");
+    }
+}
+
+void ArrayBinaryReader::next(const char*& data, int& length) {
+    if (end_ - pos_ < 4) {
+        throw std::runtime_error("Invalid binary array: truncated element");
+    }
+    length = static_cast<int32_t>(readBE32(pos_));
+    pos_ += 4;
+    
+    if (length < 0) {
+        data = nullptr;
+        length = 0;
+        return;
+    }
+    if (end_ - pos_ < length) {
+        throw std::runtime_error("Invalid binary array: truncated element");
+    }
+    data = pos_;
+    pos_ += length;
+}
+
+void appendBinaryArrayHeader(std::string& out, Oid elementOid,
+                             std::size_t count, bool hasNull) {
+    out.reserve(out.size() + kArrayHeaderSize + kArrayDimensionSize);
+    appendBE32(out, count == 0 ? 0u : 1u);
+    appendBE32(out, hasNull ? 1u : 0u);
+    appendBE32(out, elementOid);
+    if (count > 0) {
+        appendBE32(out, static_cast<uint32_t>(count));
+        appendBE32(out, 1u);  // Lower bound
+    }
+}
+
+void throwNullArrayElement(const char* typeName) {
+    throw std::runtime_error(
+        std::string("NULL element in array of non-optional type: ") + typeName);
+}
+
+} // namespace detail
+} // namespace pq
@@ -0,0 +1,81 @@
+/**
+ * @file Bytea.cpp
+ * @brief Implementation of the bytea text codec
+ */
+
+#include "pq/core/Bytea.hpp"
+#include "pq/core/Hex.hpp"
+#include <cstring>
+#include <stdexcept>
+
+namespace pq {
+namespace detail {
+
+namespace {
+
+[[noreturn]] void throwInvalidBytea(const char* reason) {
+    throw std::invalid_argument(std::string("Invalid input syntax for type bytea: ") + reason);
+}
+
+inline bool isOctal(char c) noexcept {
+    return c >= '0' && c <= '7';
+}
+
+// Legacy escape format: printable bytes as-is, \\ for backslash, \ooo octal
+std::vector<std::byte> decodeEscape(const char* str, std::size_t length) {
+    std::vector<std::byte> out;
+    out.reserve(length);
+    for (std::size_t i = 0; i < length; ++i) {
+        if (str[i] != '\\') {
+            out.push_back(static_cast<std::byte>(str[i]));
+        } else if (i + 1 < length && str[i + 1] == '\\') {
+            out.push_back(std::byte{'\\'});
+            ++i;
+        } else if (i + 3 < length && isOctal(str[i + 1]) && isOctal(str[i + 2]) &&
+                   isOctal(str[i + 3]) && str[i + 1] <= '3') {
+            const int value = ((str[i + 1] - '0') << 6) | ((str[i + 2] - '0') << 3) |
+                              (str[i + 3] - '0');
+            out.push_back(static_cast<std::byte>(value));
+            i += 3;
+        } else {
+            throwInvalidBytea("bad escape sequence");
+        }
+    }
+    return out;
+}
+
+} // namespace
+
+std::string encodeByteaText(BytesView bytes) {
+    std::string out(2 + 2 * bytes.size(), '\0');
+    out[0] = '\\';
+    out[1] = 'x';
+    hexEncode(reinterpret_cast<const unsigned char*>(bytes.data()), bytes.size(), out.data() + 2);
+    return out;
+}
+
+std::vector<std::byte> decodeByteaText(const char* str) {
+    if (!str) {
+        return {};
+    }
+    const std::size_t length = std::strlen(str);
+    
+    if (length < 2 || str[0] != '\\' || str[1] != 'x') {
+        return decodeEscape(str, length);
+    }
+    
+    const char* hex = str + 2;
+    const std::size_t hexLength = length - 2;
+    if (hexLength % 2 != 0) {
+        throwInvalidBytea("odd number of hex digits");
+    }
+    
+    std::vector<std::byte> out(hexLength / 2);
+    if (!hexDecode(hex, out.size(), reinterpret_cast<unsigned char*>(out.data()))) {
+        throwInvalidBytea("invalid hexadecimal digit");
+    }
+    return out;
+}
+
+} // namespace detail
+} // namespace pq
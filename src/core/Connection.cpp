@@ -4,12 +4,22 @@
  */
 
 #include "pq/core/Connection.hpp"
+#include <algorithm>
 #include <sstream>
 #include <cstring>
+#include <cerrno>
+#include <poll.h>
 
 namespace pq {
 namespace core {
 
+namespace {
+
+constexpr const char* kInvalidStatementName = "26000";
+constexpr const char* kDuplicatePreparedStatement = "42P05";
+
+} // namespace
+
 // ConnectionConfig implementation
 
 std::string ConnectionConfig::toConnectionString() const {
@@ -58,6 +68,7 @@ Connection::Connection(const ConnectionConfig& config) {
 }
 
 DbResult<void> Connection::connect(std::string_view connectionString) {
+    prepared_.clear();
     NullTerminatedString connStr(connectionString);
     conn_ = makePgConn(connStr.c_str());
     
@@ -75,6 +86,8 @@ DbResult<void> Connection::connect(const ConnectionConfig& config) {
 void Connection::disconnect() noexcept {
     conn_.reset();
     inTransaction_ = false;
+    prepared_.clear();
+    afterCommit_.clear();
 }
 
 bool Connection::isConnected() const noexcept {
@@ -116,7 +129,8 @@ DbResult<QueryResult> Connection::execute(std::string_view sql,
 }
 
 DbResult<QueryResult> Connection::execute(std::string_view sql,
-                                           const std::vector<std::string>& params) {
+                                           const std::vector<std::string>& params,
+                                           Format resultFormat) {
     if (!isConnected()) {
         return DbResult<QueryResult>::error(DbError{"Not connected"});
     }
@@ -138,7 +152,7 @@ DbResult<QueryResult> Connection::execute(std::string_view sql,
         paramValues.data(),
         nullptr,  // Text format
         nullptr,  // Text format
-        0         // Text format result
+        static_cast<int>(resultFormat)
     ));
     
     QueryResult qr(std::move(result));
@@ -189,6 +203,7 @@ DbResult<void> Connection::prepare(std::string_view name, std::string_view sql)
         return DbResult<void>::error(makeError(qr, "prepare"));
     }
     
+    prepared_.emplace(name);
     return DbResult<void>::ok();
 }
 
@@ -225,6 +240,177 @@ DbResult<QueryResult> Connection::executePrepared(std::string_view name,
     return qr;
 }
 
+DbResult<QueryResult> Connection::executePrepared(std::string_view name,
+                                                   const std::vector<std::string>& params,
+                                                   Format resultFormat) {
+    if (!isConnected()) {
+        return DbResult<QueryResult>::error(DbError{"Not connected"});
+    }
+    
+    std::vector<const char*> paramValues;
+    paramValues.reserve(params.size());
+    for (const auto& p : params) {
+        // Empty string represents NULL
+        paramValues.push_back(p.empty() ? nullptr : p.c_str());
+    }
+    
+    NullTerminatedString nameStr(name);
+    
+    PgResultPtr result(PQexecPrepared(
+        conn_.get(),
+        nameStr.c_str(),
+        static_cast<int>(paramValues.size()),
+        paramValues.data(),
+        nullptr,  // Text format
+        nullptr,  // Text format
+        static_cast<int>(resultFormat)
+    ));
+    
+    QueryResult qr(std::move(result));
+    
+    if (!qr.isSuccess()) {
+        return DbResult<QueryResult>::error(makeError(qr, "executePrepared"));
+    }
+    
+    return qr;
+}
+
+DbResult<QueryResult> Connection::executeStatement(std::string_view name, std::string_view sql,
+                                                    const std::vector<std::string>& params,
+                                                    Format resultFormat) {
+    if (!isPrepared(name)) {
+        auto prepared = prepare(name, sql);
+        if (!prepared) {
+            // Prepared earlier on this session without going through prepare().
+            // A failed PREPARE aborts an open transaction, so only outside
+            // one can the existing statement still be used.
+            if (prepared.error().sqlState != kDuplicatePreparedStatement) {
+                return DbResult<QueryResult>::error(std::move(prepared).error());
+            }
+            prepared_.emplace(name);
+            if (inTransaction_) {
+                return DbResult<QueryResult>::error(std::move(prepared).error());
+            }
+        }
+    }
+    
+    auto result = executePrepared(name, params, resultFormat);
+    if (result || result.error().sqlState != kInvalidStatementName) {
+        return result;
+    }
+    
+    // The server dropped the statement (DISCARD ALL, pooler reset): prepare again,
+    // unless the failure has aborted the open transaction
+    prepared_.erase(std::string(name));
+    if (inTransaction_) {
+        return result;
+    }
+    auto prepared = prepare(name, sql);
+    if (!prepared) {
+        return DbResult<QueryResult>::error(std::move(prepared).error());
+    }
+    return executePrepared(name, params, resultFormat);
+}
+
+DbResult<int> Connection::copyIn(std::string_view sql, std::string_view data) {
+    if (!isConnected()) {
+        return DbResult<int>::error(DbError{"Not connected"});
+    }
+    
+    NullTerminatedString sqlStr(sql);
+    QueryResult start(makePgResult(PQexec(conn_.get(), sqlStr.c_str())));
+    if (start.status() != PGRES_COPY_IN) {
+        if (start.isSuccess()) {
+            return DbResult<int>::error(DbError{"copyIn: not a COPY FROM STDIN statement"});
+        }
+        return DbResult<int>::error(makeError(start, "copyIn"));
+    }
+    
+    // Bounded pieces keep libpq's send buffer from growing to the whole payload
+    constexpr std::size_t chunkSize = 1 << 20;
+    bool sent = true;
+    for (std::size_t offset = 0; sent && offset < data.size(); offset += chunkSize) {
+        const std::size_t n = std::min(chunkSize, data.size() - offset);
+        sent = PQputCopyData(conn_.get(), data.data() + offset, static_cast<int>(n)) == 1;
+    }
+    
+    // A failed send still ends the COPY, aborting it, so the connection
+    // leaves COPY_IN state before the results are drained
+    std::optional<DbError> failure;
+    if (!sent) {
+        failure = makeError("copyIn");
+    }
+    if (PQputCopyEnd(conn_.get(), sent ? nullptr : "copyIn aborted") != 1 && !failure) {
+        failure = makeError("copyIn");
+    }
+    if (failure) {
+        while (PGresult* rest = PQgetResult(conn_.get())) {
+            PQclear(rest);
+        }
+        return DbResult<int>::error(std::move(*failure));
+    }
+    
+    QueryResult end(makePgResult(PQgetResult(conn_.get())));
+    while (PGresult* rest = PQgetResult(conn_.get())) {
+        PQclear(rest);
+    }
+    if (!end.isSuccess()) {
+        return DbResult<int>::error(makeError(end, "copyIn"));
+    }
+    return end.affectedRows();
+}
+
+DbResult<void> Connection::listen(std::string_view channel) {
+    auto result = execute("LISTEN " + escapeIdentifier(channel));
+    if (!result) {
+        return DbResult<void>::error(std::move(result).error());
+    }
+    return DbResult<void>::ok();
+}
+
+DbResult<void> Connection::unlisten(std::string_view channel) {
+    auto result = execute("UNLISTEN " + escapeIdentifier(channel));
+    if (!result) {
+        return DbResult<void>::error(std::move(result).error());
+    }
+    return DbResult<void>::ok();
+}
+
+DbResult<std::vector<Notification>> Connection::notifications(std::chrono::milliseconds timeout) {
+    if (!isConnected()) {
+        return DbResult<std::vector<Notification>>::error(DbError{"Not connected"});
+    }
+    
+    std::vector<Notification> received;
+    auto collect = [&]() -> bool {
+        if (!PQconsumeInput(conn_.get())) {
+            return false;
+        }
+        while (PGnotify* notify = PQnotifies(conn_.get())) {
+            received.push_back(Notification{notify->relname, notify->extra ? notify->extra : "",
+                                            notify->be_pid});
+            PQfreemem(notify);
+        }
+        return true;
+    };
+    
+    if (!collect()) {
+        return DbResult<std::vector<Notification>>::error(makeError("notifications"));
+    }
+    if (received.empty() && timeout.count() > 0) {
+        pollfd fd{PQsocket(conn_.get()), POLLIN, 0};
+        const int ready = poll(&fd, 1, static_cast<int>(timeout.count()));
+        if (ready < 0 && errno != EINTR) {
+            return DbResult<std::vector<Notification>>::error(
+                DbError{std::string("notifications: ") + std::strerror(errno)});
+        }
+        if (ready > 0 && !collect()) {
+            return DbResult<std::vector<Notification>>::error(makeError("notifications"));
+        }
+    }
+    return received;
+}
+
 DbResult<void> Connection::beginTransaction() {
     if (inTransaction_) {
         return DbResult<void>::error(DbError{"Already in transaction"});
@@ -246,11 +432,23 @@ DbResult<void> Connection::commit() {
     
     auto result = execute("COMMIT");
     inTransaction_ = false;
+    auto callbacks = std::move(afterCommit_);
+    afterCommit_.clear();
     
+    // A COMMIT that fails (deferred constraint, serialization failure) rolls
+    // back, and one of an already failed transaction reports ROLLBACK
     if (!result) {
+        ++rollbacks_;
         return DbResult<void>::error(std::move(result).error());
     }
+    if (std::string_view(PQcmdStatus(result->raw())) != "COMMIT") {
+        ++rollbacks_;
+        return DbResult<void>::ok();
+    }
     
+    for (auto& callback : callbacks) {
+        callback();
+    }
     return DbResult<void>::ok();
 }
 
@@ -261,6 +459,8 @@ DbResult<void> Connection::rollback() {
     
     auto result = execute("ROLLBACK");
     inTransaction_ = false;
+    ++rollbacks_;
+    afterCommit_.clear();
     
     if (!result) {
         return DbResult<void>::error(std::move(result).error());
@@ -269,6 +469,14 @@ DbResult<void> Connection::rollback() {
     return DbResult<void>::ok();
 }
 
+void Connection::afterCommit(std::function<void()> fn) {
+    if (!inTransaction_) {
+        fn();
+        return;
+    }
+    afterCommit_.push_back(std::move(fn));
+}
+
 std::string Connection::escapeString(std::string_view value) const {
     if (!isConnected()) {
         return std::string(value);
@@ -328,4 +536,20 @@ DbError Connection::makeError(const QueryResult& result, const char* context) co
 }
 
 } // namespace core
+
+namespace detail {
+
+void appendCopyField(std::string& out, std::string_view value) {
+    for (char c : value) {
+        switch (c) {
+            case '\\': out += "\\\\"; break;
+            case '\t': out += "\\t"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            default: out.push_back(c); break;
+        }
+    }
+}
+
+} // namespace detail
 } // namespace pq
@@ -166,6 +166,14 @@ DbResult<std::unique_ptr<Connection>> ConnectionPool::createConnection() {
         return DbResult<std::unique_ptr<Connection>>::error(std::move(result).error());
     }
     
+    // No query once every name is cached
+    if (!config_.typeNames.empty()) {
+        auto loaded = types_.load(*conn, config_.typeNames);
+        if (!loaded) {
+            return DbResult<std::unique_ptr<Connection>>::error(std::move(loaded).error());
+        }
+    }
+    
     return std::move(conn);
 }
 
@@ -0,0 +1,742 @@
+/**
+ * @file Decimal.cpp
+ * @brief Implementation of the exact NUMERIC decimal type
+ */
+
+#include "pq/core/Decimal.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <stdexcept>
+
+namespace pq {
+
+namespace {
+
+using Coefficient = Decimal::Coefficient;
+using Limbs = Decimal::Limbs;
+
+constexpr uint32_t kLimbBase = 1000000000u;  // 1e9
+constexpr int kLimbDigits = 9;
+constexpr int kCompactLimbs = (detail::decimalCompactDigits + kLimbDigits - 1) / kLimbDigits;
+constexpr int32_t kMaxExponent = 100000;
+
+// NUMERIC binary sign words (src/include/utils/numeric.h)
+constexpr uint16_t kNumericPos  = 0x0000;
+constexpr uint16_t kNumericNeg  = 0x4000;
+constexpr uint16_t kNumericNaN  = 0xC000;
+constexpr uint16_t kNumericPInf = 0xD000;
+constexpr uint16_t kNumericNInf = 0xF000;
+constexpr uint16_t kNumericDscaleMask = 0x3FFF;
+
+constexpr uint32_t kSmallPow10[] = {
+    1u, 10u, 100u, 1000u, 10000u, 100000u, 1000000u, 10000000u, 100000000u, 1000000000u
+};
+
+// ----------------------------------------------------------------------------
+// Magnitude arithmetic on base-1e9 limbs (least significant first)
+// ----------------------------------------------------------------------------
+
+void trim(Limbs& a) {
+    while (!a.empty() && a.back() == 0) {
+        a.pop_back();
+    }
+}
+
+int compareMagnitude(const Limbs& a, const Limbs& b) {
+    if (a.size() != b.size()) {
+        return a.size() < b.size() ? -1 : 1;
+    }
+    for (std::size_t i = a.size(); i-- > 0;) {
+        if (a[i] != b[i]) {
+            return a[i] < b[i] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+void mulSmall(Limbs& a, uint32_t m, uint32_t add = 0) {
+    uint64_t carry = add;
+    for (auto& limb : a) {
+        const uint64_t cur = static_cast<uint64_t>(limb) * m + carry;
+        limb = static_cast<uint32_t>(cur % kLimbBase);
+        carry = cur / kLimbBase;
+    }
+    while (carry) {
+        a.push_back(static_cast<uint32_t>(carry % kLimbBase));
+        carry /= kLimbBase;
+    }
+    trim(a);
+}
+
+uint32_t divSmall(Limbs& a, uint32_t d) {
+    uint64_t rem = 0;
+    for (std::size_t i = a.size(); i-- > 0;) {
+        const uint64_t cur = a[i] + rem * kLimbBase;
+        a[i] = static_cast<uint32_t>(cur / d);
+        rem = cur % d;
+    }
+    trim(a);
+    return static_cast<uint32_t>(rem);
+}
+
+void mulPow10(Limbs& a, int32_t n) {
+    if (a.empty()) {
+        return;
+    }
+    if (n >= kLimbDigits) {
+        a.insert(a.begin(), static_cast<std::size_t>(n / kLimbDigits), 0u);
+        n %= kLimbDigits;
+    }
+    if (n > 0) {
+        mulSmall(a, kSmallPow10[n]);
+    }
+}
+
+// Divide by 10^n; returns the most significant discarded digit
+uint32_t divPow10(Limbs& a, int32_t n) {
+    if (n <= 0) {
+        return 0;
+    }
+    if (n - 1 >= kLimbDigits) {
+        const auto drop = static_cast<std::size_t>((n - 1) / kLimbDigits);
+        a.erase(a.begin(), a.begin() + static_cast<std::ptrdiff_t>(std::min(drop, a.size())));
+        n -= static_cast<int32_t>(drop) * kLimbDigits;
+    }
+    if (n > 1) {
+        divSmall(a, kSmallPow10[n - 1]);
+    }
+    return divSmall(a, 10);
+}
+
+Limbs addMagnitude(const Limbs& a, const Limbs& b) {
+    Limbs r(std::max(a.size(), b.size()) + 1, 0u);
+    uint32_t carry = 0;
+    for (std::size_t i = 0; i + 1 < r.size(); ++i) {
+        uint32_t cur = carry;
+        if (i < a.size()) cur += a[i];
+        if (i < b.size()) cur += b[i];
+        carry = cur >= kLimbBase ? 1u : 0u;
+        r[i] = cur - carry * kLimbBase;
+    }
+    r.back() = carry;
+    trim(r);
+    return r;
+}
+
+// Requires a >= b
+Limbs subMagnitude(const Limbs& a, const Limbs& b) {
+    Limbs r(a.size(), 0u);
+    int64_t borrow = 0;
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        const int64_t cur = static_cast<int64_t>(a[i]) - borrow - (i < b.size() ? b[i] : 0);
+        borrow = cur < 0 ? 1 : 0;
+        r[i] = static_cast<uint32_t>(cur + borrow * kLimbBase);
+    }
+    trim(r);
+    return r;
+}
+
+Limbs mulMagnitude(const Limbs& a, const Limbs& b) {
+    if (a.empty() || b.empty()) {
+        return {};
+    }
+    std::vector<uint64_t> acc(a.size() + b.size(), 0u);
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        uint64_t carry = 0;
+        for (std::size_t j = 0; j < b.size(); ++j) {
+            const uint64_t cur = acc[i + j] + static_cast<uint64_t>(a[i]) * b[j] + carry;
+            acc[i + j] = cur % kLimbBase;
+            carry = cur / kLimbBase;
+        }
+        acc[i + b.size()] += carry;
+    }
+    Limbs r(acc.begin(), acc.end());
+    trim(r);
+    return r;
+}
+
+Limbs limbsOf(Coefficient magnitude) {
+    Limbs r;
+    while (magnitude > 0) {
+        r.push_back(static_cast<uint32_t>(magnitude % kLimbBase));
+        magnitude /= kLimbBase;
+    }
+    return r;
+}
+
+std::string digitsOf(Limbs a) {
+    if (a.empty()) {
+        return "0";
+    }
+    std::string out;
+    while (!a.empty()) {
+        uint32_t chunk = divSmall(a, kLimbBase);
+        for (int i = 0; i < kLimbDigits && (chunk != 0 || !a.empty()); ++i) {
+            out.push_back(static_cast<char>('0' + chunk % 10));
+            chunk /= 10;
+        }
+    }
+    std::reverse(out.begin(), out.end());
+    return out;
+}
+
+std::string digitsOf(Coefficient magnitude) {
+    char buf[64];
+    char* const end = buf + sizeof(buf);
+    char* p = end;
+    do {
+        *--p = static_cast<char>('0' + static_cast<int>(magnitude % 10));
+        magnitude /= 10;
+    } while (magnitude > 0);
+    return std::string(p, end);
+}
+
+Coefficient absCoefficient(Coefficient c) {
+    return c < 0 ? -c : c;
+}
+
+// Multiply a compact coefficient by 10^n if the result stays compact
+bool scaleUpCompact(Coefficient& coef, int32_t n) {
+    if (n > detail::decimalCompactDigits) {
+        return coef == 0;
+    }
+    const Coefficient factor = detail::decimalPow10(n);
+    if (absCoefficient(coef) >= detail::decimalCompactLimit / factor) {
+        return coef == 0;
+    }
+    coef *= factor;
+    return true;
+}
+
+bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+}
+
+bool equalsIgnoreCase(std::string_view a, std::string_view lower) {
+    if (a.size() != lower.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        char c = a[i];
+        if (c >= 'A' && c <= 'Z') {
+            c = static_cast<char>(c - 'A' + 'a');
+        }
+        if (c != lower[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+[[noreturn]] void throwInvalid(std::string_view text) {
+    throw std::invalid_argument("Invalid numeric value: \"" + std::string(text) + "\"");
+}
+
+} // namespace
+
+// ============================================================================
+// Wide (sign-magnitude) form
+// ============================================================================
+
+struct Decimal::Wide {
+    bool negative{false};
+    Limbs magnitude;
+    int32_t scale{0};
+    
+    void alignWith(Wide& other) {
+        if (scale < other.scale) {
+            mulPow10(magnitude, other.scale - scale);
+            scale = other.scale;
+        } else if (other.scale < scale) {
+            mulPow10(other.magnitude, scale - other.scale);
+            other.scale = scale;
+        }
+    }
+};
+
+Decimal Decimal::makeCompact(Coefficient coef, int32_t scale) noexcept {
+    Decimal d;
+    d.coef_ = coef;
+    d.scale_ = scale;
+    return d;
+}
+
+Decimal Decimal::fromWide(Wide&& wide) {
+    trim(wide.magnitude);
+    if (static_cast<int>(wide.magnitude.size()) <= kCompactLimbs) {
+        Coefficient value = 0;
+        for (std::size_t i = wide.magnitude.size(); i-- > 0;) {
+            value = value * kLimbBase + wide.magnitude[i];
+        }
+        if (value < detail::decimalCompactLimit) {
+            return makeCompact(wide.negative ? -value : value, wide.scale);
+        }
+    }
+    Decimal d;
+    d.scale_ = wide.scale;
+    d.negative_ = wide.negative;
+    d.big_ = std::make_shared<const Limbs>(std::move(wide.magnitude));
+    return d;
+}
+
+Decimal::Wide Decimal::toWide() const {
+    Wide w;
+    w.scale = scale_;
+    if (big_) {
+        w.negative = negative_;
+        w.magnitude = *big_;
+    } else {
+        w.negative = coef_ < 0;
+        w.magnitude = limbsOf(absCoefficient(coef_));
+    }
+    return w;
+}
+
+// ============================================================================
+// Construction and conversion
+// ============================================================================
+
+Decimal Decimal::nan() noexcept {
+    Decimal d;
+    d.kind_ = Kind::NaN;
+    return d;
+}
+
+Decimal Decimal::infinity(bool negative) noexcept {
+    Decimal d;
+    d.kind_ = negative ? Kind::NegativeInfinity : Kind::PositiveInfinity;
+    return d;
+}
+
+Decimal Decimal::fromScaled(int64_t unscaled, int32_t scale) {
+    if (scale < 0) {
+        throw std::invalid_argument("Decimal scale must not be negative");
+    }
+    Wide w;
+    w.negative = unscaled < 0;
+    uint64_t magnitude = w.negative ? 0u - static_cast<uint64_t>(unscaled)
+                                    : static_cast<uint64_t>(unscaled);
+    while (magnitude > 0) {
+        w.magnitude.push_back(static_cast<uint32_t>(magnitude % kLimbBase));
+        magnitude /= kLimbBase;
+    }
+    w.scale = scale;
+    return fromWide(std::move(w));
+}
+
+Decimal Decimal::fromString(std::string_view text) {
+    std::string_view s = text;
+    while (!s.empty() && isSpace(s.front())) s.remove_prefix(1);
+    while (!s.empty() && isSpace(s.back())) s.remove_suffix(1);
+    
+    if (equalsIgnoreCase(s, "nan")) {
+        return nan();
+    }
+    
+    bool negative = false;
+    std::size_t pos = 0;
+    if (pos < s.size() && (s[pos] == '+' || s[pos] == '-')) {
+        negative = s[pos] == '-';
+        ++pos;
+    }
+    
+    const std::string_view rest = s.substr(pos);
+    if (equalsIgnoreCase(rest, "infinity") || equalsIgnoreCase(rest, "inf")) {
+        return infinity(negative);
+    }
+    
+    // Scan mantissa: locate digits and the decimal point in one pass
+    const std::size_t mantissaBegin = pos;
+    int32_t fractionDigits = 0;
+    int significantDigits = 0;
+    bool seenPoint = false;
+    bool seenDigit = false;
+    Coefficient coef = 0;
+    for (; pos < s.size(); ++pos) {
+        const char c = s[pos];
+        if (c >= '0' && c <= '9') {
+            seenDigit = true;
+            if (seenPoint) ++fractionDigits;
+            if (significantDigits > 0 || c != '0') {
+                if (++significantDigits <= detail::decimalCompactDigits) {
+                    coef = coef * 10 + (c - '0');
+                }
+            }
+        } else if (c == '.' && !seenPoint) {
+            seenPoint = true;
+        } else {
+            break;
+        }
+    }
+    if (!seenDigit) {
+        throwInvalid(text);
+    }
+    const std::size_t mantissaEnd = pos;
+    
+    int32_t exponent = 0;
+    if (pos < s.size() && (s[pos] == 'e' || s[pos] == 'E')) {
+        ++pos;
+        bool expNegative = false;
+        if (pos < s.size() && (s[pos] == '+' || s[pos] == '-')) {
+            expNegative = s[pos] == '-';
+            ++pos;
+        }
+        if (pos == s.size()) {
+            throwInvalid(text);
+        }
+        for (; pos < s.size(); ++pos) {
+            const char c = s[pos];
+            if (c < '0' || c > '9') {
+                throwInvalid(text);
+            }
+            exponent = exponent * 10 + (c - '0');
+            if (exponent > kMaxExponent) {
+                throwInvalid(text);
+            }
+        }
+        if (expNegative) {
+            exponent = -exponent;
+        }
+    }
+    if (pos != s.size()) {
+        throwInvalid(text);
+    }
+    
+    int32_t scale = fractionDigits - exponent;
+    
+    if (significantDigits <= detail::decimalCompactDigits) {
+        if (scale < 0) {
+            if (scaleUpCompact(coef, -scale)) {
+                return makeCompact(negative ? -coef : coef, 0);
+            }
+        } else {
+            return makeCompact(negative ? -coef : coef, scale);
+        }
+    }
+    
+    // Arbitrary precision: rebuild the magnitude from the digit sequence
+    Wide w;
+    w.negative = negative;
+    uint32_t chunk = 0;
+    int chunkDigits = 0;
+    for (std::size_t i = mantissaBegin; i < mantissaEnd; ++i) {
+        if (s[i] == '.') continue;
+        chunk = chunk * 10 + static_cast<uint32_t>(s[i] - '0');
+        if (++chunkDigits == kLimbDigits) {
+            mulSmall(w.magnitude, kLimbBase, chunk);
+            chunk = 0;
+            chunkDigits = 0;
+        }
+    }
+    if (chunkDigits > 0) {
+        mulSmall(w.magnitude, kSmallPow10[chunkDigits], chunk);
+    }
+    if (scale < 0) {
+        mulPow10(w.magnitude, -scale);
+        scale = 0;
+    }
+    w.scale = scale;
+    if (w.magnitude.empty()) {
+        w.negative = false;
+    }
+    return fromWide(std::move(w));
+}
+
+Decimal Decimal::fromBinary(const char* data, int length) {
+    if (length < 8) {
+        throw std::runtime_error("Invalid binary numeric: header too short");
+    }
+    const int ndigits = static_cast<int16_t>(detail::readBE16(data));
+    const int weight = static_cast<int16_t>(detail::readBE16(data + 2));
+    const uint16_t sign = detail::readBE16(data + 4);
+    const int32_t dscale = detail::readBE16(data + 6) & kNumericDscaleMask;
+    
+    switch (sign) {
+        case kNumericNaN:  return nan();
+        case kNumericPInf: return infinity(false);
+        case kNumericNInf: return infinity(true);
+        case kNumericPos:
+        case kNumericNeg:  break;
+        default:
+            throw std::runtime_error("Invalid binary numeric: bad sign word");
+    }
+    if (ndigits < 0 || length != 8 + 2 * ndigits) {
+        throw std::runtime_error("Invalid binary numeric: length mismatch");
+    }
+    const bool negative = sign == kNumericNeg;
+    
+    // value = D * 10000^(weight - ndigits + 1), D = the base-10000 digits
+    // coefficient at dscale = D * 10^(4 * (weight - ndigits + 1) + dscale)
+    const int32_t shift = 4 * (weight - ndigits + 1) + dscale;
+    
+    Coefficient coef = 0;
+    bool compact = true;
+    Limbs wide;
+    for (int i = 0; i < ndigits; ++i) {
+        const uint16_t digit = detail::readBE16(data + 8 + 2 * i);
+        if (digit >= 10000) {
+            throw std::runtime_error("Invalid binary numeric: digit out of range");
+        }
+        if (compact && coef < detail::decimalCompactLimit / 10000) {
+            coef = coef * 10000 + digit;
+            continue;
+        }
+        if (compact) {
+            wide = limbsOf(coef);
+            compact = false;
+        }
+        mulSmall(wide, 10000, digit);
+    }
+    
+    if (compact) {
+        if (shift >= 0) {
+            if (scaleUpCompact(coef, shift)) {
+                return makeCompact(negative ? -coef : coef, dscale);
+            }
+            wide = limbsOf(coef);
+            compact = false;
+        } else {
+            // Trailing zeros of the last base-10000 group beyond dscale
+            coef /= detail::decimalPow10(std::min<int32_t>(-shift, detail::decimalCompactDigits));
+            return makeCompact(negative ? -coef : coef, dscale);
+        }
+    }
+    
+    Wide w;
+    w.negative = negative;
+    w.magnitude = std::move(wide);
+    if (shift >= 0) {
+        mulPow10(w.magnitude, shift);
+    } else {
+        divPow10(w.magnitude, -shift);
+    }
+    w.scale = dscale;
+    return fromWide(std::move(w));
+}
+
+std::string Decimal::toString() const {
+    switch (kind_) {
+        case Kind::NaN:              return "NaN";
+        case Kind::PositiveInfinity: return "Infinity";
+        case Kind::NegativeInfinity: return "-Infinity";
+        case Kind::Finite:           break;
+    }
+    
+    std::string digits = big_ ? digitsOf(*big_) : digitsOf(absCoefficient(coef_));
+    if (scale_ > 0) {
+        const auto scale = static_cast<std::size_t>(scale_);
+        if (digits.size() <= scale) {
+            digits.insert(0, scale + 1 - digits.size(), '0');
+        }
+        digits.insert(digits.size() - scale, 1, '.');
+    }
+    if (isNegative()) {
+        digits.insert(0, 1, '-');
+    }
+    return digits;
+}
+
+double Decimal::toDouble() const {
+    switch (kind_) {
+        case Kind::NaN:              return std::numeric_limits<double>::quiet_NaN();
+        case Kind::PositiveInfinity: return std::numeric_limits<double>::infinity();
+        case Kind::NegativeInfinity: return -std::numeric_limits<double>::infinity();
+        case Kind::Finite:           break;
+    }
+    
+    // Exact when both the coefficient and 10^scale are representable doubles
+    constexpr Coefficient kMaxExactDouble = Coefficient{1} << 53;
+    constexpr double kExactPow10[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    if (!big_ && scale_ <= 22 && absCoefficient(coef_) <= kMaxExactDouble) {
+        return static_cast<double>(coef_) / kExactPow10[scale_];
+    }
+    return std::strtod(toString().c_str(), nullptr);
+}
+
+// ============================================================================
+// Arithmetic
+// ============================================================================
+
+Decimal Decimal::rescale(int32_t newScale) const {
+    if (newScale < 0) {
+        throw std::invalid_argument("Decimal scale must not be negative");
+    }
+    if (kind_ != Kind::Finite || newScale == scale_) {
+        return *this;
+    }
+    
+    if (!big_) {
+        Coefficient coef = coef_;
+        if (newScale > scale_) {
+            if (scaleUpCompact(coef, newScale - scale_)) {
+                return makeCompact(coef, newScale);
+            }
+        } else {
+            const int32_t drop = scale_ - newScale;
+            if (drop > detail::decimalCompactDigits) {
+                return makeCompact(0, newScale);  // |coef| < 10^(drop - 1)
+            }
+            const Coefficient divisor = detail::decimalPow10(drop);
+            Coefficient quotient = coef / divisor;
+            const Coefficient remainder = absCoefficient(coef % divisor);
+            if (remainder * 2 >= divisor) {
+                quotient += coef < 0 ? -1 : 1;  // Half away from zero
+            }
+            return makeCompact(quotient, newScale);
+        }
+    }
+    
+    Wide w = toWide();
+    if (newScale > scale_) {
+        mulPow10(w.magnitude, newScale - scale_);
+    } else if (divPow10(w.magnitude, scale_ - newScale) >= 5) {
+        mulSmall(w.magnitude, 1, 1);
+    }
+    w.scale = newScale;
+    if (w.magnitude.empty()) {
+        w.negative = false;
+    }
+    return fromWide(std::move(w));
+}
+
+int Decimal::compare(const Decimal& other) const {
+    // NaN == NaN and NaN > everything; -Infinity < finite < +Infinity
+    auto rank = [](Kind k) {
+        switch (k) {
+            case Kind::NegativeInfinity: return 0;
+            case Kind::Finite:           return 1;
+            case Kind::PositiveInfinity: return 2;
+            case Kind::NaN:              return 3;
+        }
+        return 1;
+    };
+    const int ra = rank(kind_);
+    const int rb = rank(other.kind_);
+    if (ra != rb || kind_ != Kind::Finite) {
+        return ra < rb ? -1 : (ra > rb ? 1 : 0);
+    }
+    
+    if (!big_ && !other.big_) {
+        Coefficient a = coef_;
+        Coefficient b = other.coef_;
+        if ((scale_ >= other.scale_ || scaleUpCompact(a, other.scale_ - scale_)) &&
+            (other.scale_ >= scale_ || scaleUpCompact(b, scale_ - other.scale_))) {
+            return a < b ? -1 : (a > b ? 1 : 0);
+        }
+    }
+    
+    Wide a = toWide();
+    Wide b = other.toWide();
+    const bool aNeg = a.negative && !a.magnitude.empty();
+    const bool bNeg = b.negative && !b.magnitude.empty();
+    if (aNeg != bNeg) {
+        return aNeg ? -1 : 1;
+    }
+    a.alignWith(b);
+    const int cmp = compareMagnitude(a.magnitude, b.magnitude);
+    return aNeg ? -cmp : cmp;
+}
+
+Decimal Decimal::operator-() const {
+    switch (kind_) {
+        case Kind::NaN:              return *this;
+        case Kind::PositiveInfinity: return infinity(true);
+        case Kind::NegativeInfinity: return infinity(false);
+        case Kind::Finite:           break;
+    }
+    Decimal d = *this;
+    if (big_) {
+        d.negative_ = !negative_;
+    } else {
+        d.coef_ = -coef_;
+    }
+    return d;
+}
+
+Decimal& Decimal::addSlow(const Decimal& rhs, bool subtract) {
+    if (kind_ == Kind::NaN || rhs.kind_ == Kind::NaN) {
+        return *this = nan();
+    }
+    const bool rhsNegative = rhs.isNegative() != subtract;
+    if (isInfinite() || rhs.isInfinite()) {
+        if (isInfinite() && rhs.isInfinite() && isNegative() != rhsNegative) {
+            return *this = nan();  // Infinity - Infinity
+        }
+        return *this = infinity(isInfinite() ? isNegative() : rhsNegative);
+    }
+    
+    // Compact operands with different scales
+    if (!big_ && !rhs.big_) {
+        const int32_t scale = std::max(scale_, rhs.scale_);
+        Coefficient a = coef_;
+        Coefficient b = subtract ? -rhs.coef_ : rhs.coef_;
+        if (scaleUpCompact(a, scale - scale_) && scaleUpCompact(b, scale - rhs.scale_)) {
+            const Coefficient sum = a + b;
+            if (sum < detail::decimalCompactLimit && sum > -detail::decimalCompactLimit) {
+                return *this = makeCompact(sum, scale);
+            }
+        }
+    }
+    
+    Wide a = toWide();
+    Wide b = rhs.toWide();
+    b.negative = rhsNegative;
+    a.alignWith(b);
+    
+    Wide r;
+    r.scale = a.scale;
+    if (a.negative == b.negative) {
+        r.negative = a.negative;
+        r.magnitude = addMagnitude(a.magnitude, b.magnitude);
+    } else if (compareMagnitude(a.magnitude, b.magnitude) >= 0) {
+        r.negative = a.negative;
+        r.magnitude = subMagnitude(a.magnitude, b.magnitude);
+    } else {
+        r.negative = b.negative;
+        r.magnitude = subMagnitude(b.magnitude, a.magnitude);
+    }
+    if (r.magnitude.empty()) {
+        r.negative = false;
+    }
+    return *this = fromWide(std::move(r));
+}
+
+Decimal& Decimal::operator*=(const Decimal& rhs) {
+    if (isCompact() && rhs.isCompact()) {
+        const Coefficient a = absCoefficient(coef_);
+        const Coefficient b = absCoefficient(rhs.coef_);
+        if (b == 0 || a < detail::decimalCompactLimit / b) {
+            coef_ *= rhs.coef_;
+            scale_ += rhs.scale_;
+            return *this;
+        }
+    }
+    return multiplySlow(rhs);
+}
+
+Decimal& Decimal::multiplySlow(const Decimal& rhs) {
+    if (kind_ == Kind::NaN || rhs.kind_ == Kind::NaN) {
+        return *this = nan();
+    }
+    const bool negative = isNegative() != rhs.isNegative();
+    if (isInfinite() || rhs.isInfinite()) {
+        if (isZero() || rhs.isZero()) {
+            return *this = nan();  // Infinity * 0
+        }
+        return *this = infinity(negative);
+    }
+    
+    Wide a = toWide();
+    Wide b = rhs.toWide();
+    Wide r;
+    r.magnitude = mulMagnitude(a.magnitude, b.magnitude);
+    r.negative = negative && !r.magnitude.empty();
+    r.scale = scale_ + rhs.scale_;
+    return *this = fromWide(std::move(r));
+}
+
+} // namespace pq
@@ -0,0 +1,136 @@
+/**
+ * @file Hex.cpp
+ * @brief Implementation of the vectorized hex codec
+ */
+
+#include "pq/core/Hex.hpp"
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PQ_HEX_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace pq {
+namespace detail {
+
+namespace {
+
+constexpr char kHexDigits[] = "0123456789abcdef";
+
+// Nibble value of an ASCII hex digit, or -1
+constexpr int8_t nibbleOf(unsigned char c) noexcept {
+    if (c >= '0' && c <= '9') return static_cast<int8_t>(c - '0');
+    if (c >= 'a' && c <= 'f') return static_cast<int8_t>(c - 'a' + 10);
+    if (c >= 'A' && c <= 'F') return static_cast<int8_t>(c - 'A' + 10);
+    return -1;
+}
+
+struct NibbleTable {
+    int8_t values[256];
+    
+    constexpr NibbleTable() noexcept : values() {
+        for (int i = 0; i < 256; ++i) {
+            values[i] = nibbleOf(static_cast<unsigned char>(i));
+        }
+    }
+};
+
+constexpr NibbleTable kNibbles{};
+
+#ifdef PQ_HEX_SSE2
+
+// Map 16 nibbles (0-15 per byte) to their ASCII digits
+inline __m128i nibblesToAscii(__m128i nibbles) noexcept {
+    const __m128i nine = _mm_set1_epi8(9);
+    const __m128i letterOffset = _mm_set1_epi8('a' - '0' - 10);
+    const __m128i isLetter = _mm_cmpgt_epi8(nibbles, nine);
+    const __m128i ascii = _mm_add_epi8(nibbles, _mm_set1_epi8('0'));
+    return _mm_add_epi8(ascii, _mm_and_si128(isLetter, letterOffset));
+}
+
+// Convert 16 ASCII hex digits to nibbles; clears `valid` on bad input
+inline __m128i asciiToNibbles(__m128i chars, __m128i& valid) noexcept {
+    // Bytes >= 0x80 compare as negative and fail both range checks
+    const __m128i digits = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+    const __m128i isDigit = _mm_and_si128(
+        _mm_cmpgt_epi8(digits, _mm_set1_epi8(-1)),
+        _mm_cmplt_epi8(digits, _mm_set1_epi8(10)));
+    
+    const __m128i lower = _mm_or_si128(chars, _mm_set1_epi8(0x20));
+    const __m128i letters = _mm_sub_epi8(lower, _mm_set1_epi8('a'));
+    const __m128i isLetter = _mm_and_si128(
+        _mm_cmpgt_epi8(letters, _mm_set1_epi8(-1)),
+        _mm_cmplt_epi8(letters, _mm_set1_epi8(6)));
+    
+    valid = _mm_and_si128(valid, _mm_or_si128(isDigit, isLetter));
+    
+    const __m128i letterValues = _mm_add_epi8(letters, _mm_set1_epi8(10));
+    return _mm_or_si128(_mm_and_si128(isDigit, digits),
+                        _mm_and_si128(isLetter, letterValues));
+}
+
+// Pack 16 nibbles (high, low, high, low, ...) into 8 bytes in 16-bit lanes
+inline __m128i packNibblePairs(__m128i nibbles) noexcept {
+    const __m128i high = _mm_slli_epi16(_mm_and_si128(nibbles, _mm_set1_epi16(0x00FF)), 4);
+    const __m128i low = _mm_srli_epi16(nibbles, 8);
+    return _mm_or_si128(high, low);
+}
+
+#endif // PQ_HEX_SSE2
+
+} // namespace
+
+void hexEncode(const unsigned char* in, std::size_t size, char* out) noexcept {
+    std::size_t i = 0;
+
+#ifdef PQ_HEX_SSE2
+    const __m128i lowMask = _mm_set1_epi8(0x0F);
+    for (; i + 16 <= size; i += 16) {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        const __m128i high = _mm_and_si128(_mm_srli_epi16(bytes, 4), lowMask);
+        const __m128i low = _mm_and_si128(bytes, lowMask);
+        const __m128i first = nibblesToAscii(_mm_unpacklo_epi8(high, low));
+        const __m128i second = nibblesToAscii(_mm_unpackhi_epi8(high, low));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i), first);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i + 16), second);
+    }
+#endif
+
+    for (; i < size; ++i) {
+        out[2 * i] = kHexDigits[in[i] >> 4];
+        out[2 * i + 1] = kHexDigits[in[i] & 0x0F];
+    }
+}
+
+bool hexDecode(const char* in, std::size_t size, unsigned char* out) noexcept {
+    std::size_t i = 0;
+
+#ifdef PQ_HEX_SSE2
+    __m128i valid = _mm_set1_epi8(-1);
+    for (; i + 16 <= size; i += 16) {
+        const __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 2 * i));
+        const __m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 2 * i + 16));
+        const __m128i packed = _mm_packus_epi16(
+            packNibblePairs(asciiToNibbles(first, valid)),
+            packNibblePairs(asciiToNibbles(second, valid)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), packed);
+    }
+    if (_mm_movemask_epi8(valid) != 0xFFFF) {
+        return false;
+    }
+#endif
+
+    for (; i < size; ++i) {
+        const int8_t high = kNibbles.values[static_cast<unsigned char>(in[2 * i])];
+        const int8_t low = kNibbles.values[static_cast<unsigned char>(in[2 * i + 1])];
+        if ((high | low) < 0) {
+            return false;
+        }
+        out[i] = static_cast<unsigned char>((high << 4) | low);
+    }
+    return true;
+}
+
+} // namespace detail
+} // namespace pq
@@ -0,0 +1,423 @@
+/**
+ * @file Jsonb.cpp
+ * @brief Implementation of the on-demand JSON scanner
+ */
+
+#include "pq/core/Jsonb.hpp"
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__SSE2__)
+#define PQ_JSON_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace pq {
+
+namespace {
+
+[[noreturn]] void throwMalformed(const char* reason) {
+    throw std::runtime_error(std::string("Malformed JSON: ") + reason);
+}
+
+[[noreturn]] void throwTypeMismatch(const char* expected, std::string_view text) {
+    constexpr std::size_t kPreview = 32;
+    std::string preview(text.substr(0, kPreview));
+    if (text.size() > kPreview) {
+        preview += "...";
+    }
+    throw std::runtime_error(std::string("JSON value is not ") + expected + ": " + preview);
+}
+
+inline bool isJsonSpace(char c) noexcept {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+inline const char* skipSpace(const char* p, const char* end) noexcept {
+    while (p < end && isJsonSpace(*p)) ++p;
+    return p;
+}
+
+// p points at the opening quote; returns one past the closing quote
+const char* skipString(const char* p, const char* end) {
+    ++p;
+#ifdef PQ_JSON_SSE2
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    while (end - p >= 16) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const int mask = _mm_movemask_epi8(_mm_or_si128(
+            _mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)));
+        if (mask == 0) {
+            p += 16;
+            continue;
+        }
+        p += __builtin_ctz(static_cast<unsigned>(mask));
+        if (*p == '"') {
+            return p + 1;
+        }
+        p += 2;  // Skip the escaped character
+    }
+#endif
+    while (p < end) {
+        if (*p == '"') {
+            return p + 1;
+        }
+        p += (*p == '\\') ? 2 : 1;
+    }
+    throwMalformed("unterminated string");
+}
+
+// p points at the first character of a value; returns one past its end
+const char* skipValue(const char* p, const char* end) {
+    if (p >= end) {
+        throwMalformed("unexpected end of input");
+    }
+    switch (*p) {
+    case '"':
+        return skipString(p, end);
+    case '{':
+    case '[': {
+        int depth = 0;
+        while (p < end) {
+            const char c = *p;
+            if (c == '"') {
+                p = skipString(p, end);
+                continue;
+            }
+            if (c == '{' || c == '[') {
+                ++depth;
+            } else if (c == '}' || c == ']') {
+                if (--depth == 0) {
+                    return p + 1;
+                }
+            }
+            ++p;
+        }
+        throwMalformed("unterminated container");
+    }
+    case ',':
+    case ':':
+    case '}':
+    case ']':
+        throwMalformed("expected a value");
+    default: {
+        // Scalars: numbers and literals run until a structural character
+        const char* start = p;
+        while (p < end && *p != ',' && *p != '}' && *p != ']' && *p != ':' &&
+               !isJsonSpace(*p)) {
+            ++p;
+        }
+        if (p == start) {
+            throwMalformed("expected a value");
+        }
+        return p;
+    }
+    }
+}
+
+inline int hexValue(char c) noexcept {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+uint32_t readHex4(const char* p, const char* end) {
+    if (end - p < 4) {
+        throwMalformed("truncated \\u escape");
+    }
+    uint32_t value = 0;
+    for (int i = 0; i < 4; ++i) {
+        const int digit = hexValue(p[i]);
+        if (digit < 0) {
+            throwMalformed("invalid \\u escape");
+        }
+        value = (value << 4) | static_cast<uint32_t>(digit);
+    }
+    return value;
+}
+
+void appendUtf8(std::string& out, uint32_t cp) {
+    if (cp < 0x80) {
+        out.push_back(static_cast<char>(cp));
+    } else if (cp < 0x800) {
+        out.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+        out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    } else if (cp < 0x10000) {
+        out.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    } else {
+        out.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    }
+}
+
+// Compare a quoted key against `key` without unescaping in the common case
+bool keyEquals(std::string_view quoted, std::string_view key, const JsonView& view) {
+    const std::string_view body = quoted.substr(1, quoted.size() - 2);
+    if (body.find('\\') == std::string_view::npos) {
+        return body == key;
+    }
+    return view.asString() == key;
+}
+
+} // namespace
+
+// ----------------------------------------------------------------------------
+// JsonCursor
+// ----------------------------------------------------------------------------
+
+namespace detail {
+
+JsonCursor::JsonCursor(std::string_view text, char open)
+    : pos(text.data())
+    , end(text.data() + text.size())
+    , done(false) {
+    if (text.empty() || text[0] != open) {
+        throwTypeMismatch(open == '{' ? "an object" : "an array", text);
+    }
+    ++pos;
+    pos = skipSpace(pos, end);
+    if (pos < end && *pos == (open == '{' ? '}' : ']')) {
+        done = true;
+    }
+}
+
+bool JsonCursor::advance(char close) {
+    pos = skipSpace(pos, end);
+    if (pos >= end) {
+        throwMalformed("unexpected end of input");
+    }
+    if (*pos == ',') {
+        pos = skipSpace(pos + 1, end);
+    } else if (*pos == close) {
+        done = true;
+    } else {
+        throwMalformed("expected ',' or closing bracket");
+    }
+    return true;
+}
+
+bool JsonCursor::nextElement(JsonView& value) {
+    if (done) {
+        return false;
+    }
+    const char* start = pos;
+    pos = skipValue(pos, end);
+    value = JsonView::fromRange(start, pos);
+    return advance(']');
+}
+
+bool JsonCursor::nextMember(JsonView& key, JsonView& value) {
+    if (done) {
+        return false;
+    }
+    if (pos >= end || *pos != '"') {
+        throwMalformed("expected an object key");
+    }
+    const char* keyStart = pos;
+    pos = skipString(pos, end);
+    key = JsonView::fromRange(keyStart, pos);
+    
+    pos = skipSpace(pos, end);
+    if (pos >= end || *pos != ':') {
+        throwMalformed("expected ':' after object key");
+    }
+    pos = skipSpace(pos + 1, end);
+    
+    const char* valueStart = pos;
+    pos = skipValue(pos, end);
+    value = JsonView::fromRange(valueStart, pos);
+    return advance('}');
+}
+
+} // namespace detail
+
+// ----------------------------------------------------------------------------
+// JsonView
+// ----------------------------------------------------------------------------
+
+JsonView::JsonView(std::string_view text) noexcept {
+    std::size_t begin = 0;
+    std::size_t end = text.size();
+    while (begin < end && isJsonSpace(text[begin])) ++begin;
+    while (end > begin && isJsonSpace(text[end - 1])) --end;
+    text_ = text.substr(begin, end - begin);
+}
+
+JsonView::Type JsonView::type() const {
+    if (text_.empty()) {
+        throwMalformed("empty value");
+    }
+    switch (text_[0]) {
+    case 'n': return Type::Null;
+    case 't':
+    case 'f': return Type::Bool;
+    case '"': return Type::String;
+    case '[': return Type::Array;
+    case '{': return Type::Object;
+    default:
+        if (text_[0] == '-' || (text_[0] >= '0' && text_[0] <= '9')) {
+            return Type::Number;
+        }
+        throwMalformed("unexpected character");
+    }
+}
+
+std::optional<JsonView> JsonView::find(std::string_view key) const {
+    detail::JsonCursor cursor(text_, '{');
+    JsonView name;
+    JsonView value;
+    while (cursor.nextMember(name, value)) {
+        if (keyEquals(name.text_, key, name)) {
+            return value;
+        }
+    }
+    return std::nullopt;
+}
+
+std::optional<JsonView> JsonView::find(std::size_t index) const {
+    detail::JsonCursor cursor(text_, '[');
+    JsonView value;
+    for (std::size_t i = 0; cursor.nextElement(value); ++i) {
+        if (i == index) {
+            return value;
+        }
+    }
+    return std::nullopt;
+}
+
+JsonView JsonView::operator[](std::string_view key) const {
+    auto value = find(key);
+    if (!value) {
+        throw std::out_of_range("JSON key not found: " + std::string(key));
+    }
+    return *value;
+}
+
+JsonView JsonView::operator[](std::size_t index) const {
+    auto value = find(index);
+    if (!value) {
+        throw std::out_of_range("JSON index out of range: " + std::to_string(index));
+    }
+    return *value;
+}
+
+std::size_t JsonView::size() const {
+    std::size_t count = 0;
+    if (isObject()) {
+        detail::JsonCursor cursor(text_, '{');
+        JsonView key;
+        JsonView value;
+        while (cursor.nextMember(key, value)) ++count;
+    } else {
+        detail::JsonCursor cursor(text_, '[');
+        JsonView value;
+        while (cursor.nextElement(value)) ++count;
+    }
+    return count;
+}
+
+bool JsonView::asBool() const {
+    if (text_ == "true") return true;
+    if (text_ == "false") return false;
+    throwTypeMismatch("a boolean", text_);
+}
+
+int64_t JsonView::asInt64() const {
+    int64_t value = 0;
+    const char* first = text_.data();
+    const char* last = first + text_.size();
+    const auto [ptr, ec] = std::from_chars(first, last, value);
+    if (ec != std::errc() || ptr != last) {
+        throwTypeMismatch("a 64-bit integer", text_);
+    }
+    return value;
+}
+
+double JsonView::asDouble() const {
+    if (type() != Type::Number) {
+        throwTypeMismatch("a number", text_);
+    }
+    const std::string number(text_);
+    char* parsedEnd = nullptr;
+    const double value = std::strtod(number.c_str(), &parsedEnd);
+    if (parsedEnd != number.c_str() + number.size()) {
+        throwTypeMismatch("a number", text_);
+    }
+    return value;
+}
+
+std::string JsonView::asString() const {
+    if (text_.size() < 2 || text_.front() != '"' || text_.back() != '"') {
+        throwTypeMismatch("a string", text_);
+    }
+    
+    const char* p = text_.data() + 1;
+    const char* end = text_.data() + text_.size() - 1;
+    std::string out;
+    out.reserve(static_cast<std::size_t>(end - p));
+    
+    while (p < end) {
+        const auto* escape = static_cast<const char*>(
+            std::memchr(p, '\\', static_cast<std::size_t>(end - p)));
+        if (!escape) {
+            out.append(p, end);
+            break;
+        }
+        out.append(p, escape);
+        p = escape + 1;
+        if (p >= end) {
+            throwMalformed("dangling escape");
+        }
+        switch (*p++) {
+        case '"':  out.push_back('"'); break;
+        case '\\': out.push_back('\\'); break;
+        case '/':  out.push_back('/'); break;
+        case 'b':  out.push_back('\b'); break;
+        case 'f':  out.push_back('\f'); break;
+        case 'n':  out.push_back('\n'); break;
+        case 'r':  out.push_back('\r'); break;
+        case 't':  out.push_back('\t'); break;
+        case 'u': {
+            uint32_t cp = readHex4(p, end);
+            p += 4;
+            if (cp >= 0xD800 && cp <= 0xDBFF && end - p >= 6 && p[0] == '\\' && p[1] == 'u') {
+                const uint32_t low = readHex4(p + 2, end);
+                if (low >= 0xDC00 && low <= 0xDFFF) {
+                    cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                    p += 6;
+                }
+            }
+            appendUtf8(out, cp);
+            break;
+        }
+        default:
+            throwMalformed("invalid escape");
+        }
+    }
+    return out;
+}
+
+// ----------------------------------------------------------------------------
+// Jsonb
+// ----------------------------------------------------------------------------
+
+Jsonb Jsonb::fromBinary(const char* data, int length) {
+    if (length < 1) {
+        throw std::runtime_error("Invalid binary jsonb: empty value");
+    }
+    if (data[0] != binaryVersion) {
+        throw std::runtime_error(
+            "Unsupported binary jsonb version: " + std::to_string(static_cast<int>(data[0])));
+    }
+    return Jsonb(std::string(data + 1, static_cast<std::size_t>(length - 1)));
+}
+
+} // namespace pq
@@ -0,0 +1,162 @@
+/**
+ * @file Record.cpp
+ * @brief Implementation of the record text and binary codecs
+ */
+
+#include "pq/core/Record.hpp"
+#include <stdexcept>
+
+namespace pq {
+namespace detail {
+
+namespace {
+
+constexpr std::size_t kFieldHeaderSize = 8;  // type OID, length
+
+inline bool isRecordSpace(char c) noexcept {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+}
+
+inline bool needsQuoting(std::string_view value) noexcept {
+    if (value.empty()) {
+        return true;  // Unquoted empty text would read back as NULL
+    }
+    for (char c : value) {
+        if (c == '(' || c == ')' || c == ',' || c == '"' || c == '\\' || isRecordSpace(c)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+// ----------------------------------------------------------------------------
+// Text format
+// ----------------------------------------------------------------------------
+
+void appendRecordField(std::string& out, std::string_view value) {
+    if (!needsQuoting(value)) {
+        out.append(value);
+        return;
+    }
+    out.push_back('"');
+    for (char c : value) {
+        if (c == '"' || c == '\\') {
+            out.push_back(c);  // Doubled, as record_out writes them
+        }
+        out.push_back(c);
+    }
+    out.push_back('"');
+}
+
+RecordTextParser::RecordTextParser(const char* text)
+    : pos_(text ? text : "")
+    , text_(pos_) {
+    while (isRecordSpace(*pos_)) ++pos_;
+    if (*pos_ != '(') fail("record value must start with \"(\"");
+    ++pos_;
+}
+
+void RecordTextParser::next(std::string& field, bool& isNull) {
+    if (closed_) fail("too few fields");
+    started_ = true;
+    
+    field.clear();
+    isNull = true;
+    bool inQuotes = false;
+    
+    while (inQuotes || (*pos_ != ',' && *pos_ != ')')) {
+        const char c = *pos_;
+        if (c == '\0') fail("unexpected end of input");
+        isNull = false;
+        
+        if (c == '\\') {
+            ++pos_;
+            if (*pos_ == '\0') fail("unexpected end of input");
+            field.push_back(*pos_++);
+        } else if (c == '"') {
+            if (inQuotes && pos_[1] == '"') {
+                field.push_back('"');
+                pos_ += 2;
+            } else {
+                inQuotes = !inQuotes;
+                ++pos_;
+            }
+        } else {
+            field.push_back(c);
+            ++pos_;
+        }
+    }
+    
+    if (*pos_ == ')') {
+        close();
+    } else {
+        ++pos_;
+    }
+}
+
+void RecordTextParser::finish() {
+    if (closed_) {
+        return;
+    }
+    if (!started_ && *pos_ == ')') {
+        close();  // "()" with no fields expected
+        return;
+    }
+    fail("too many fields");
+}
+
+void RecordTextParser::close() {
+    ++pos_;
+    while (isRecordSpace(*pos_)) ++pos_;
+    if (*pos_ != '\0') fail("junk after closing \")\"");
+    closed_ = true;
+}
+
+void RecordTextParser::fail(const char* reason) const {
+    throw std::invalid_argument(
+        std::string("Malformed record literal \"") + text_ + "\": " + reason);
+}
+
+// ----------------------------------------------------------------------------
+// Binary format
+// ----------------------------------------------------------------------------
+
+RecordBinaryReader::RecordBinaryReader(const char* data, int length)
+    : pos_(data)
+    , end_(data + (length > 0 ? length : 0)) {
+    if (end_ - pos_ < 4) {
+        throw std::runtime_error("Invalid binary record: truncated header");
+    }
+    count_ = static_cast<int32_t>(readBE32(pos_));
+    pos_ += 4;
+    
+    if (count_ < 0 ||
+        static_cast<std::size_t>(count_) > static_cast<std::size_t>(end_ - pos_) / kFieldHeaderSize) {
+        throw std::runtime_error("Invalid binary record: bad field count");
+    }
+}
+
+void RecordBinaryReader::next(Oid& type, const char*& data, int& length) {
+    if (static_cast<std::size_t>(end_ - pos_) < kFieldHeaderSize) {
+        throw std::runtime_error("Invalid binary record: truncated field");
+    }
+    type = readBE32(pos_);
+    length = static_cast<int32_t>(readBE32(pos_ + 4));
+    pos_ += kFieldHeaderSize;
+    
+    if (length < 0) {
+        data = nullptr;
+        length = 0;
+        return;
+    }
+    if (end_ - pos_ < length) {
+        throw std::runtime_error("Invalid binary record: truncated field");
+    }
+    data = pos_;
+    pos_ += length;
+}
+
+} // namespace detail
+} // namespace pq
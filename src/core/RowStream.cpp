@@ -0,0 +1,103 @@
+/**
+ * @file RowStream.cpp
+ * @brief Implementation of single-row mode result streaming
+ */
+
+#include "pq/core/RowStream.hpp"
+#include <utility>
+
+namespace pq {
+namespace core {
+
+DbResult<RowStream> RowStream::open(Connection& conn, std::string_view sql,
+                                    const std::vector<std::string>& params) {
+    if (!conn.isConnected()) {
+        return DbResult<RowStream>::error(DbError{"Not connected"});
+    }
+    
+    std::vector<const char*> paramValues;
+    paramValues.reserve(params.size());
+    for (const auto& p : params) {
+        // Empty string represents NULL
+        paramValues.push_back(p.empty() ? nullptr : p.c_str());
+    }
+    
+    NullTerminatedString sqlStr(sql);
+    
+    if (!PQsendQueryParams(conn.raw(), sqlStr.c_str(),
+                           static_cast<int>(paramValues.size()),
+                           nullptr, paramValues.data(), nullptr, nullptr, 0)) {
+        return DbResult<RowStream>::error(conn.makeError("stream"));
+    }
+    
+    RowStream stream(conn);
+    if (!PQsetSingleRowMode(conn.raw())) {
+        stream.finish();
+        return DbResult<RowStream>::error(DbError{"stream: could not enter single-row mode"});
+    }
+    return stream;
+}
+
+RowStream::RowStream(RowStream&& other) noexcept
+    : conn_(std::exchange(other.conn_, nullptr))
+    , error_(std::move(other.error_)) {}
+
+RowStream& RowStream::operator=(RowStream&& other) noexcept {
+    if (this != &other) {
+        close();
+        conn_ = std::exchange(other.conn_, nullptr);
+        error_ = std::move(other.error_);
+    }
+    return *this;
+}
+
+RowStream::~RowStream() {
+    close();
+}
+
+std::optional<QueryResult> RowStream::next() {
+    if (!conn_) {
+        return std::nullopt;
+    }
+    
+    QueryResult result(makePgResult(PQgetResult(conn_->raw())));
+    switch (result.status()) {
+        case PGRES_SINGLE_TUPLE:
+            return result;
+        case PGRES_TUPLES_OK:
+        case PGRES_COMMAND_OK:
+            break;  // Terminating result: no more rows
+        default:
+            error_ = conn_->makeError(result, "stream");
+            break;
+    }
+    finish();
+    return std::nullopt;
+}
+
+void RowStream::close() noexcept {
+    if (!conn_) {
+        return;
+    }
+    
+    // Without a cancel the server would still send every remaining row; inside
+    // a transaction block the rows are drained instead, as a cancel would abort it
+    PGcancel* cancel = conn_->inTransaction() ? nullptr : PQgetCancel(conn_->raw());
+    if (cancel) {
+        char errbuf[256];
+        PQcancel(cancel, errbuf, sizeof(errbuf));
+        PQfreeCancel(cancel);
+    }
+    finish();
+}
+
+void RowStream::finish() noexcept {
+    // Drain until libpq reports the query complete, so the connection is usable again
+    while (PGresult* result = PQgetResult(conn_->raw())) {
+        PQclear(result);
+    }
+    conn_ = nullptr;
+}
+
+} // namespace core
+} // namespace pq
@@ -158,6 +158,7 @@ DbResult<void> Savepoint::rollbackTo() {
     
     std::string sql = "ROLLBACK TO SAVEPOINT " + conn_->escapeIdentifier(name_);
     auto result = conn_->execute(sql);
+    ++conn_->rollbacks_;
     
     // Note: After rollback, savepoint still exists
     return result.hasValue() ? DbResult<void>::ok() 
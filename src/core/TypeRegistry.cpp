@@ -0,0 +1,121 @@
+/**
+ * @file TypeRegistry.cpp
+ * @brief Implementation of the runtime type OID registry
+ */
+
+#include "pq/core/TypeRegistry.hpp"
+#include "pq/core/Array.hpp"
+#include <mutex>
+
+namespace pq {
+namespace core {
+
+namespace {
+
+// to_regtype() accepts the same spellings as a ::regtype cast and yields
+// NULL instead of an error for unknown names
+constexpr const char* kLoadTypesSql =
+    "SELECT n.name, t.oid::int8, t.typarray::int8, t.typtype "
+    "FROM unnest($1::text[]) AS n(name) "
+    "JOIN pg_catalog.pg_type t ON t.oid = pg_catalog.to_regtype(n.name)";
+
+} // namespace
+
+DbResult<void> TypeRegistry::load(Connection& conn, const std::vector<std::string>& names) {
+    std::vector<std::string> missing;
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        for (const auto& name : names) {
+            if (!name.empty() && byName_.find(name) == byName_.end()) {
+                missing.push_back(name);
+            }
+        }
+    }
+    if (missing.empty()) {
+        return DbResult<void>::ok();
+    }
+    
+    auto result = conn.execute(kLoadTypesSql,
+                               {PgTypeTraits<std::vector<std::string>>::toString(missing)});
+    if (!result) {
+        return DbResult<void>::error(std::move(result).error());
+    }
+    
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    for (const auto& row : *result) {
+        PgTypeInfo info;
+        info.name = row.get<std::string>(0);
+        info.oid = static_cast<Oid>(row.get<int64_t>(1));
+        info.arrayOid = static_cast<Oid>(row.get<int64_t>(2));
+        const std::string kind = row.get<std::string>(3);
+        info.kind = kind.empty() ? 'b' : kind[0];
+        addLocked(std::move(info));
+    }
+    return DbResult<void>::ok();
+}
+
+DbResult<PgTypeInfo> TypeRegistry::resolve(Connection& conn, std::string_view name) {
+    if (auto info = find(name)) {
+        return *info;
+    }
+    
+    auto loaded = load(conn, {std::string(name)});
+    if (!loaded) {
+        return DbResult<PgTypeInfo>::error(std::move(loaded).error());
+    }
+    if (auto info = find(name)) {
+        return *info;
+    }
+    return DbResult<PgTypeInfo>::error(
+        DbError{"Type does not exist: " + std::string(name)});
+}
+
+std::optional<PgTypeInfo> TypeRegistry::find(std::string_view name) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto it = byName_.find(std::string(name));
+    if (it == byName_.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+std::optional<PgTypeInfo> TypeRegistry::findByOid(Oid oid) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto it = nameByOid_.find(oid);
+    if (it == nameByOid_.end()) {
+        return std::nullopt;
+    }
+    return byName_.at(it->second);
+}
+
+void TypeRegistry::add(PgTypeInfo info) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    addLocked(std::move(info));
+}
+
+void TypeRegistry::clear() {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    byName_.clear();
+    nameByOid_.clear();
+}
+
+std::size_t TypeRegistry::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return byName_.size();
+}
+
+void TypeRegistry::addLocked(PgTypeInfo info) {
+    if (info.arrayOid != 0) {
+        PgTypeInfo array;
+        array.name = info.name + "[]";
+        array.oid = info.arrayOid;
+        array.kind = 'b';
+        nameByOid_.emplace(array.oid, array.name);
+        byName_[array.name] = std::move(array);
+    }
+    nameByOid_.emplace(info.oid, info.name);
+    byName_[info.name] = std::move(info);
+}
+
+} // namespace core
+} // namespace pq
@@ -0,0 +1,96 @@
+/**
+ * @file Uuid.cpp
+ * @brief Implementation of the UUID text codec
+ */
+
+#include "pq/core/Uuid.hpp"
+#include "pq/core/Hex.hpp"
+#include <stdexcept>
+
+namespace pq {
+
+namespace {
+
+constexpr std::size_t kHexLength = 2 * Uuid::size;
+
+[[noreturn]] void throwInvalidUuid(std::string_view text) {
+    throw std::invalid_argument(
+        "Invalid input syntax for type uuid: \"" + std::string(text) + "\"");
+}
+
+// Collect the 32 hex digits, accepting a hyphen after any group of four
+// digits like PostgreSQL's uuid_in()
+bool gatherDigits(std::string_view text, char* digits) noexcept {
+    std::size_t count = 0;
+    bool hyphenAllowed = false;
+    for (char c : text) {
+        if (c == '-') {
+            if (!hyphenAllowed) {
+                return false;
+            }
+            hyphenAllowed = false;
+            continue;
+        }
+        if (count == kHexLength) {
+            return false;
+        }
+        digits[count++] = c;
+        hyphenAllowed = (count % 4 == 0) && count < kHexLength;
+    }
+    return count == kHexLength;
+}
+
+} // namespace
+
+Uuid Uuid::fromString(std::string_view text) {
+    std::string_view body = text;
+    if (body.size() >= 2 && body.front() == '{' && body.back() == '}') {
+        body = body.substr(1, body.size() - 2);
+    }
+    
+    char digits[kHexLength];
+    const char* hex = digits;
+    
+    if (body.size() == textLength && body[8] == '-' && body[13] == '-' &&
+        body[18] == '-' && body[23] == '-') {
+        // Canonical form: drop the hyphens with fixed-offset copies
+        std::memcpy(digits, body.data(), 8);
+        std::memcpy(digits + 8, body.data() + 9, 4);
+        std::memcpy(digits + 12, body.data() + 14, 4);
+        std::memcpy(digits + 16, body.data() + 19, 4);
+        std::memcpy(digits + 20, body.data() + 24, 12);
+    } else if (body.size() == kHexLength) {
+        hex = body.data();
+    } else if (!gatherDigits(body, digits)) {
+        throwInvalidUuid(text);
+    }
+    
+    Uuid uuid;
+    if (!detail::hexDecode(hex, size, uuid.bytes_.data())) {
+        throwInvalidUuid(text);
+    }
+    return uuid;
+}
+
+void Uuid::toChars(char* out) const noexcept {
+    char hex[kHexLength];
+    detail::hexEncode(bytes_.data(), size, hex);
+    
+    std::memcpy(out, hex, 8);
+    out[8] = '-';
+    std::memcpy(out + 9, hex + 8, 4);
+    out[13] = '-';
+    std::memcpy(out + 14, hex + 12, 4);
+    out[18] = '-';
+    std::memcpy(out + 19, hex + 16, 4);
+    out[23] = '-';
+    std::memcpy(out + 24, hex + 20, 12);
+}
+
+std::string Uuid::toString() const {
+    std::string text(textLength, '\0');
+    toChars(text.data());
+    return text;
+}
+
+} // namespace pq
@@ -0,0 +1,174 @@
+/**
+ * @file test_array.cpp
+ * @brief Unit tests for std::vector<T> array support
+ */
+
+#include <gtest/gtest.h>
+#include <pq/core/Array.hpp>
+#include <pq/core/Uuid.hpp>
+#include <pq/core/Decimal.hpp>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace pq;
+
+class ArrayTest : public ::testing::Test {
+protected:
+    // Build a one-dimensional binary array; nullopt elements are NULL
+    static std::string binaryArray(Oid elementOid,
+                                   const std::vector<std::optional<std::string>>& elements) {
+        std::string out;
+        bool hasNull = false;
+        for (const auto& e : elements) {
+            hasNull = hasNull || !e;
+        }
+        detail::appendBinaryArrayHeader(out, elementOid, elements.size(), hasNull);
+        for (const auto& e : elements) {
+            if (!e) {
+                detail::appendBE32(out, 0xFFFFFFFFu);
+                continue;
+            }
+            detail::appendBE32(out, static_cast<uint32_t>(e->size()));
+            out.append(*e);
+        }
+        return out;
+    }
+};
+
+TEST_F(ArrayTest, TypeTraits) {
+    EXPECT_EQ(PgTypeTraits<std::vector<int32_t>>::pgOid, oid::INT4_ARRAY);
+    EXPECT_EQ(PgTypeTraits<std::vector<int64_t>>::pgOid, oid::INT8_ARRAY);
+    EXPECT_EQ(PgTypeTraits<std::vector<std::string>>::pgOid, oid::TEXT_ARRAY);
+    EXPECT_EQ(PgTypeTraits<std::vector<Uuid>>::pgOid, oid::UUID_ARRAY);
+    EXPECT_EQ(PgTypeTraits<std::vector<std::optional<double>>>::pgOid, oid::FLOAT8_ARRAY);
+    EXPECT_STREQ(PgTypeTraits<std::vector<int32_t>>::pgTypeName, "integer[]");
+    EXPECT_FALSE(PgTypeTraits<std::vector<int32_t>>::isNullable);
+    
+    EXPECT_TRUE(hasArrayTypeV<int64_t>);
+    EXPECT_TRUE(hasArrayTypeV<std::optional<std::string>>);
+    EXPECT_FALSE(hasArrayTypeV<std::vector<int32_t>>);
+    
+    EXPECT_TRUE(hasBinaryDecoderV<std::vector<int32_t>>);
+    EXPECT_TRUE(hasBinaryEncoderV<std::vector<int64_t>>);
+    EXPECT_TRUE(hasBinaryDecoderV<std::vector<Decimal>>);
+    EXPECT_FALSE(hasBinaryEncoderV<std::vector<Decimal>>);
+}
+
+TEST_F(ArrayTest, FormatText) {
+    using IntArray = PgTypeTraits<std::vector<int64_t>>;
+    EXPECT_EQ(IntArray::toString({}), "{}");
+    EXPECT_EQ(IntArray::toString({1, -2, 3}), "{1,-2,3}");
+    
+    using TextArray = PgTypeTraits<std::vector<std::string>>;
+    EXPECT_EQ(TextArray::toString({"plain", "with space", "", "NULL", "a\"b\\c", "{x,y}"}),
+              R"({plain,"with space","","NULL","a\"b\\c","{x,y}"})");
+    
+    using OptArray = PgTypeTraits<std::vector<std::optional<int32_t>>>;
+    EXPECT_EQ(OptArray::toString({1, std::nullopt, 3}), "{1,NULL,3}");
+}
+
+TEST_F(ArrayTest, ParseText) {
+    using IntArray = PgTypeTraits<std::vector<int32_t>>;
+    EXPECT_EQ(IntArray::fromString("{}"), std::vector<int32_t>{});
+    EXPECT_EQ(IntArray::fromString("{1,2,3}"), (std::vector<int32_t>{1, 2, 3}));
+    EXPECT_EQ(IntArray::fromString(" { 4 , 5 } "), (std::vector<int32_t>{4, 5}));
+    EXPECT_EQ(IntArray::fromString("[0:1]={7,8}"), (std::vector<int32_t>{7, 8}));
+    
+    using TextArray = PgTypeTraits<std::vector<std::string>>;
+    EXPECT_EQ(TextArray::fromString(R"({plain,"with space","","NULL","a\"b\\c","{x,y}"})"),
+              (std::vector<std::string>{"plain", "with space", "", "NULL", "a\"b\\c", "{x,y}"}));
+    EXPECT_EQ(TextArray::fromString(R"({a\,b,  trailing  })"),
+              (std::vector<std::string>{"a,b", "trailing"}));
+    
+    using OptArray = PgTypeTraits<std::vector<std::optional<std::string>>>;
+    auto values = OptArray::fromString(R"({x,NULL,null,"NULL"})");
+    ASSERT_EQ(values.size(), 4u);
+    EXPECT_EQ(values[0], "x");
+    EXPECT_FALSE(values[1].has_value());
+    EXPECT_FALSE(values[2].has_value());
+    EXPECT_EQ(values[3], "NULL");
+}
+
+TEST_F(ArrayTest, TextRoundTrip) {
+    using TextArray = PgTypeTraits<std::vector<std::string>>;
+    const std::vector<std::string> original{"", " ", "\\", "\"", ",", "null", "многоязычный"};
+    EXPECT_EQ(TextArray::fromString(TextArray::toString(original).c_str()), original);
+    
+    using UuidArray = PgTypeTraits<std::vector<Uuid>>;
+    const std::vector<Uuid> ids{Uuid::fromString("a0eebc99-9c0b-4ef8-bb6d-6bb9bd380a11"), Uuid()};
+    EXPECT_EQ(UuidArray::fromString(UuidArray::toString(ids).c_str()), ids);
+}
+
+TEST_F(ArrayTest, ParseTextRejectsMalformedInput) {
+    using IntArray = PgTypeTraits<std::vector<int32_t>>;
+    EXPECT_THROW(IntArray::fromString("1,2"), std::invalid_argument);
+    EXPECT_THROW(IntArray::fromString("{1,2"), std::invalid_argument);
+    EXPECT_THROW(IntArray::fromString("{1,,2}"), std::invalid_argument);
+    EXPECT_THROW(IntArray::fromString("{{1,2},{3,4}}"), std::invalid_argument);
+    EXPECT_THROW(IntArray::fromString("{1} x"), std::invalid_argument);
+    EXPECT_THROW(IntArray::fromString("{\"1}"), std::invalid_argument);
+    EXPECT_THROW(IntArray::fromString("{1,NULL}"), std::runtime_error);
+}
+
+TEST_F(ArrayTest, DecodeBinary) {
+    const std::string one = PgTypeTraits<int32_t>::toBinary(1);
+    const std::string two = PgTypeTraits<int32_t>::toBinary(-2);
+    auto bin = binaryArray(oid::INT4, {one, std::nullopt, two});
+    
+    auto values = decodeValue<std::vector<std::optional<int32_t>>>(
+        bin.data(), static_cast<int>(bin.size()), Format::Binary);
+    ASSERT_EQ(values.size(), 3u);
+    EXPECT_EQ(values[0], 1);
+    EXPECT_FALSE(values[1].has_value());
+    EXPECT_EQ(values[2], -2);
+    
+    EXPECT_THROW(PgTypeTraits<std::vector<int32_t>>::fromBinary(
+                     bin.data(), static_cast<int>(bin.size())),
+                 std::runtime_error);
+    
+    auto empty = binaryArray(oid::TEXT, {});
+    EXPECT_TRUE(PgTypeTraits<std::vector<std::string>>::fromBinary(
+                    empty.data(), static_cast<int>(empty.size())).empty());
+}
+
+TEST_F(ArrayTest, DecodeBinaryRejectsMalformedInput) {
+    auto bin = binaryArray(oid::INT8, {PgTypeTraits<int64_t>::toBinary(5)});
+    using BigintArray = PgTypeTraits<std::vector<int64_t>>;
+    
+    EXPECT_THROW(BigintArray::fromBinary(bin.data(), 8), std::runtime_error);
+    EXPECT_THROW(BigintArray::fromBinary(bin.data(), static_cast<int>(bin.size()) - 1),
+                 std::runtime_error);
+    
+    std::string twoDims = bin;
+    twoDims[3] = 2;
+    EXPECT_THROW(BigintArray::fromBinary(twoDims.data(), static_cast<int>(twoDims.size())),
+                 std::runtime_error);
+}
+
+TEST_F(ArrayTest, BinaryRoundTrip) {
+    using BigintArray = PgTypeTraits<std::vector<int64_t>>;
+    const std::vector<int64_t> ids{1, -1, 9223372036854775807LL};
+    const std::string bin = BigintArray::toBinary(ids);
+    
+    EXPECT_EQ(detail::readBE32(bin.data()), 1u);         // ndim
+    EXPECT_EQ(detail::readBE32(bin.data() + 8), oid::INT8);
+    EXPECT_EQ(BigintArray::fromBinary(bin.data(), static_cast<int>(bin.size())), ids);
+    
+    using OptTextArray = PgTypeTraits<std::vector<std::optional<std::string>>>;
+    const std::vector<std::optional<std::string>> texts{"a", std::nullopt, ""};
+    const std::string textBin = OptTextArray::toBinary(texts);
+    EXPECT_EQ(detail::readBE32(textBin.data() + 4), 1u);  // has-null flag
+    EXPECT_EQ(OptTextArray::fromBinary(textBin.data(), static_cast<int>(textBin.size())), texts);
+    
+    const std::string emptyBin = BigintArray::toBinary({});
+    EXPECT_EQ(emptyBin.size(), 12u);
+    EXPECT_TRUE(BigintArray::fromBinary(emptyBin.data(), 12).empty());
+}
+
+TEST_F(ArrayTest, ParamConverterUsesArrayText) {
+    std::vector<int64_t> ids{10, 20, 30};
+    ParamConverter<std::vector<int64_t>> conv(ids);
+    EXPECT_FALSE(conv.isNull);
+    EXPECT_STREQ(conv.ptr, "{10,20,30}");
+}
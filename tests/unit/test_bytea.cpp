@@ -0,0 +1,116 @@
+/**
+ * @file test_bytea.cpp
+ * @brief Unit tests for bytea support and binary parameters
+ */
+
+#include <gtest/gtest.h>
+#include <pq/core/Bytea.hpp>
+#include <pq/core/Array.hpp>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+using namespace pq;
+
+class ByteaTest : public ::testing::Test {
+protected:
+    using Bytes = std::vector<std::byte>;
+    
+    static Bytes bytes(std::initializer_list<int> values) {
+        Bytes out;
+        for (int v : values) {
+            out.push_back(static_cast<std::byte>(v));
+        }
+        return out;
+    }
+};
+
+TEST_F(ByteaTest, TypeTraits) {
+    EXPECT_EQ(PgTypeTraits<Bytes>::pgOid, oid::BYTEA);
+    EXPECT_STREQ(PgTypeTraits<Bytes>::pgTypeName, "bytea");
+    EXPECT_EQ(PgTypeTraits<BytesView>::pgOid, oid::BYTEA);
+    EXPECT_EQ(paramFormatV<Bytes>, Format::Binary);
+    EXPECT_EQ(paramFormatV<BytesView>, Format::Binary);
+    EXPECT_EQ(paramFormatV<std::string>, Format::Text);
+    EXPECT_TRUE(hasBinaryDecoderV<Bytes>);
+    
+    // Arrays of bytea come from the generic vector traits
+    EXPECT_EQ(PgTypeTraits<std::vector<Bytes>>::pgOid, oid::BYTEA_ARRAY);
+}
+
+TEST_F(ByteaTest, TextHexRoundTrip) {
+    const Bytes data = bytes({0x00, 0x01, 0xAB, 0xFF, 0x7F});
+    const std::string text = PgTypeTraits<Bytes>::toString(data);
+    EXPECT_EQ(text, "\\x0001abff7f");
+    EXPECT_EQ(PgTypeTraits<Bytes>::fromString(text.c_str()), data);
+    EXPECT_EQ(PgTypeTraits<Bytes>::fromString("\\x0001ABFF7F"), data);
+    EXPECT_TRUE(PgTypeTraits<Bytes>::fromString("\\x").empty());
+}
+
+TEST_F(ByteaTest, TextHexLargePayload) {
+    Bytes data(4096 + 3);
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<std::byte>((i * 131) & 0xFF);
+    }
+    const std::string text = PgTypeTraits<Bytes>::toString(data);
+    EXPECT_EQ(text.size(), 2 + 2 * data.size());
+    EXPECT_EQ(PgTypeTraits<Bytes>::fromString(text.c_str()), data);
+}
+
+TEST_F(ByteaTest, TextEscapeFormat) {
+    EXPECT_EQ(PgTypeTraits<Bytes>::fromString("ab\\\\c\\000\\377"),
+              bytes({'a', 'b', '\\', 'c', 0x00, 0xFF}));
+    EXPECT_TRUE(PgTypeTraits<Bytes>::fromString("").empty());
+}
+
+TEST_F(ByteaTest, TextRejectsMalformedInput) {
+    EXPECT_THROW(PgTypeTraits<Bytes>::fromString("\\x0"), std::invalid_argument);
+    EXPECT_THROW(PgTypeTraits<Bytes>::fromString("\\xzz"), std::invalid_argument);
+    EXPECT_THROW(PgTypeTraits<Bytes>::fromString("bad\\9"), std::invalid_argument);
+}
+
+TEST_F(ByteaTest, BinaryDecoding) {
+    const char raw[] = {'\x00', '\x10', '\xff'};
+    EXPECT_EQ(decodeValue<Bytes>(raw, 3, Format::Binary), bytes({0x00, 0x10, 0xFF}));
+    
+    // BytesView points straight into the result buffer
+    const BytesView view = decodeValue<BytesView>(raw, 3, Format::Binary);
+    EXPECT_EQ(static_cast<const void*>(view.data()), static_cast<const void*>(raw));
+    EXPECT_EQ(view.size(), 3u);
+    EXPECT_EQ(view.toVector(), bytes({0x00, 0x10, 0xFF}));
+    
+    EXPECT_THROW((void)decodeValue<BytesView>("\\x00", 4, Format::Text), std::runtime_error);
+}
+
+TEST_F(ByteaTest, ParamConverterBorrowsBytes) {
+    const Bytes data = bytes({0xDE, 0xAD, 0x00, 0xEF});
+    ParamConverter<Bytes> conv(data);
+    EXPECT_FALSE(conv.isNull);
+    EXPECT_EQ(conv.format, Format::Binary);
+    EXPECT_EQ(conv.type, oid::BYTEA);
+    EXPECT_EQ(conv.length, 4);
+    EXPECT_EQ(static_cast<const void*>(conv.ptr), static_cast<const void*>(data.data()));
+    
+    ParamConverter<BytesView> viewConv{BytesView(data)};
+    EXPECT_EQ(static_cast<const void*>(viewConv.ptr), static_cast<const void*>(data.data()));
+    
+    // Empty payloads must not be mistaken for NULL
+    ParamConverter<Bytes> emptyConv(Bytes{});
+    EXPECT_NE(emptyConv.ptr, nullptr);
+    EXPECT_EQ(emptyConv.length, 0);
+    
+    ParamConverter<std::optional<Bytes>> nullConv(std::nullopt);
+    EXPECT_TRUE(nullConv.isNull);
+    EXPECT_EQ(nullConv.ptr, nullptr);
+    
+    ParamConverter<std::optional<Bytes>> someConv{std::optional<Bytes>(data)};
+    EXPECT_FALSE(someConv.isNull);
+    EXPECT_EQ(someConv.format, Format::Binary);
+}
+
+TEST_F(ByteaTest, TextParamsAreUnchanged) {
+    ParamConverter<int> conv(7);
+    EXPECT_EQ(conv.format, Format::Text);
+    EXPECT_EQ(conv.type, 0u);
+    EXPECT_STREQ(conv.ptr, "7");
+}
@@ -0,0 +1,192 @@
+/**
+ * @file test_composite.cpp
+ * @brief Unit tests for composite (record) values mapped onto entities
+ */
+
+#include <gtest/gtest.h>
+#include <pq/orm/Entity.hpp>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace pq;
+using namespace pq::orm;
+
+struct CompositeLine {
+    std::string sku;
+    int32_t quantity{0};
+    std::optional<std::string> note;
+    
+    PQ_ENTITY(CompositeLine, "composite_lines")
+        PQ_COLUMN(sku, "sku")
+        PQ_COLUMN(quantity, "quantity")
+        PQ_COLUMN(note, "note")
+    PQ_ENTITY_END()
+};
+
+PQ_REGISTER_ENTITY(CompositeLine)
+
+struct CompositeOrder {
+    int64_t id{0};
+    std::optional<CompositeLine> primary;
+    std::vector<CompositeLine> lines;
+    
+    PQ_ENTITY(CompositeOrder, "composite_orders")
+        PQ_COLUMN(id, "id", PQ_PRIMARY_KEY)
+        PQ_COLUMN(primary, "primary_line")
+        PQ_COLUMN(lines, "lines")
+    PQ_ENTITY_END()
+};
+
+PQ_REGISTER_ENTITY(CompositeOrder)
+
+class CompositeTest : public ::testing::Test {
+protected:
+    using LineTraits = PgTypeTraits<CompositeLine>;
+    
+    // Binary record: field count, then (OID, length, bytes) per field
+    static void appendField(std::string& out, Oid type, const std::string* value) {
+        detail::appendBE32(out, type);
+        if (!value) {
+            detail::appendBE32(out, 0xFFFFFFFFu);
+            return;
+        }
+        detail::appendBE32(out, static_cast<uint32_t>(value->size()));
+        out.append(*value);
+    }
+    
+    static std::string binaryLine(const std::string& sku, int32_t quantity,
+                                  const std::string* note) {
+        std::string out;
+        detail::appendBE32(out, 3);
+        appendField(out, oid::TEXT, &sku);
+        const std::string qty = PgTypeTraits<int32_t>::toBinary(quantity);
+        appendField(out, oid::INT4, &qty);
+        appendField(out, oid::TEXT, note);
+        return out;
+    }
+};
+
+TEST_F(CompositeTest, TypeTraits) {
+    EXPECT_EQ(LineTraits::pgOid, oid::RECORD);
+    EXPECT_STREQ(LineTraits::pgTypeName, "record");
+    EXPECT_TRUE(hasBinaryDecoderV<CompositeLine>);
+    EXPECT_EQ(PgTypeTraits<std::vector<CompositeLine>>::pgOid, oid::RECORD_ARRAY);
+    
+    const auto& meta = EntityMeta<CompositeOrder>::metadata();
+    EXPECT_EQ(meta.findColumn("primary_line")->info.pgType, oid::RECORD);
+    EXPECT_TRUE(meta.findColumn("primary_line")->info.isNullable);
+    EXPECT_EQ(meta.findColumn("lines")->info.pgType, oid::RECORD_ARRAY);
+}
+
+TEST_F(CompositeTest, TextRecord) {
+    const auto line = LineTraits::fromString(R"rec((ab-1,3,"needs ""gift"" wrap"))rec");
+    EXPECT_EQ(line.sku, "ab-1");
+    EXPECT_EQ(line.quantity, 3);
+    EXPECT_EQ(line.note, "needs \"gift\" wrap");
+}
+
+TEST_F(CompositeTest, TextRecordNulls) {
+    // An empty field is NULL; a quoted empty field is an empty string
+    const auto withNull = LineTraits::fromString("(x,1,)");
+    EXPECT_FALSE(withNull.note.has_value());
+    
+    const auto withEmpty = LineTraits::fromString(R"rec(("",1,""))rec");
+    EXPECT_EQ(withEmpty.sku, "");
+    EXPECT_EQ(withEmpty.note, "");
+    
+    EXPECT_THROW((void)LineTraits::fromString("(,1,)"), std::runtime_error);
+}
+
+TEST_F(CompositeTest, TextRoundTrip) {
+    const CompositeLine line{"a,b (c)", -7, std::string("back\\slash \"q\"")};
+    const std::string text = LineTraits::toString(line);
+    EXPECT_EQ(text, R"rec(("a,b (c)",-7,"back\\slash ""q"""))rec");
+    
+    const auto parsed = LineTraits::fromString(text.c_str());
+    EXPECT_EQ(parsed.sku, line.sku);
+    EXPECT_EQ(parsed.quantity, line.quantity);
+    EXPECT_EQ(parsed.note, line.note);
+    
+    EXPECT_EQ(LineTraits::toString(CompositeLine{"x", 1, std::nullopt}), "(x,1,)");
+}
+
+TEST_F(CompositeTest, TextRecordErrors) {
+    EXPECT_THROW((void)LineTraits::fromString("x,1,"), std::invalid_argument);
+    EXPECT_THROW((void)LineTraits::fromString("(x,1)"), std::invalid_argument);
+    EXPECT_THROW((void)LineTraits::fromString("(x,1,,)"), std::invalid_argument);
+    EXPECT_THROW((void)LineTraits::fromString("(x,1,\"open)"), std::invalid_argument);
+    EXPECT_THROW((void)LineTraits::fromString("(x,1,) junk"), std::invalid_argument);
+}
+
+TEST_F(CompositeTest, NestedTextGraph) {
+    // SELECT 7, ROW('a', 1, NULL), array_agg(ROW(sku, qty, note)) as text
+    const auto primary = PgTypeTraits<std::optional<CompositeLine>>::fromString("(a,1,)");
+    ASSERT_TRUE(primary.has_value());
+    EXPECT_EQ(primary->sku, "a");
+    
+    const auto lines = PgTypeTraits<std::vector<CompositeLine>>::fromString(
+        R"rec({"(a,1,)","(\"b c\",2,\"x,y\")"})rec");
+    ASSERT_EQ(lines.size(), 2u);
+    EXPECT_EQ(lines[1].sku, "b c");
+    EXPECT_EQ(lines[1].quantity, 2);
+    EXPECT_EQ(lines[1].note, "x,y");
+    
+    // Whole graph through the parent's own record text
+    const CompositeOrder order{7, CompositeLine{"a", 1, std::nullopt}, lines};
+    const std::string text = PgTypeTraits<CompositeOrder>::toString(order);
+    const auto parsed = PgTypeTraits<CompositeOrder>::fromString(text.c_str());
+    EXPECT_EQ(parsed.id, 7);
+    ASSERT_TRUE(parsed.primary.has_value());
+    EXPECT_EQ(parsed.primary->sku, "a");
+    ASSERT_EQ(parsed.lines.size(), 2u);
+    EXPECT_EQ(parsed.lines[1].note, "x,y");
+}
+
+TEST_F(CompositeTest, BinaryRecord) {
+    const std::string note = "fragile";
+    const std::string wire = binaryLine("sku-9", 12, &note);
+    const auto line = decodeValue<CompositeLine>(wire.data(), static_cast<int>(wire.size()),
+                                                 Format::Binary);
+    EXPECT_EQ(line.sku, "sku-9");
+    EXPECT_EQ(line.quantity, 12);
+    EXPECT_EQ(line.note, "fragile");
+    
+    const std::string nullNote = binaryLine("s", 1, nullptr);
+    EXPECT_FALSE(LineTraits::fromBinary(nullNote.data(), static_cast<int>(nullNote.size()))
+                     .note.has_value());
+}
+
+TEST_F(CompositeTest, BinaryArrayOfRecords) {
+    const std::string first = binaryLine("a", 1, nullptr);
+    const std::string second = binaryLine("b", 2, nullptr);
+    
+    std::string wire;
+    detail::appendBinaryArrayHeader(wire, oid::RECORD, 2, false);
+    for (const auto* element : {&first, &second}) {
+        detail::appendBE32(wire, static_cast<uint32_t>(element->size()));
+        wire.append(*element);
+    }
+    
+    const auto lines = PgTypeTraits<std::vector<CompositeLine>>::fromBinary(
+        wire.data(), static_cast<int>(wire.size()));
+    ASSERT_EQ(lines.size(), 2u);
+    EXPECT_EQ(lines[0].sku, "a");
+    EXPECT_EQ(lines[1].quantity, 2);
+}
+
+TEST_F(CompositeTest, BinaryRecordErrors) {
+    std::string twoFields;
+    detail::appendBE32(twoFields, 2);
+    const std::string sku = "a";
+    appendField(twoFields, oid::TEXT, &sku);
+    appendField(twoFields, oid::TEXT, &sku);
+    EXPECT_THROW((void)LineTraits::fromBinary(twoFields.data(),
+                                              static_cast<int>(twoFields.size())),
+                 std::runtime_error);
+    
+    const std::string wire = binaryLine("a", 1, nullptr);
+    EXPECT_THROW((void)LineTraits::fromBinary(wire.data(), static_cast<int>(wire.size()) - 1),
+                 std::runtime_error);
+    EXPECT_THROW((void)LineTraits::fromBinary(wire.data(), 2), std::runtime_error);
+}
@@ -6,6 +6,7 @@
 #include <gtest/gtest.h>
 #include <pq/core/Connection.hpp>
 #include <pq/core/Result.hpp>
+#include <pq/core/RowStream.hpp>
 #include <string>
 
 using namespace pq;
@@ -186,6 +187,53 @@ TEST_F(ConnectionTest, ExecutePreparedWithoutConnection) {
     EXPECT_TRUE(result.hasError());
 }
 
+TEST_F(ConnectionTest, ExecuteStatementWithoutConnection) {
+    Connection conn;
+    
+    auto result = conn.executeStatement("test_stmt", "SELECT $1", {"value"});
+    
+    EXPECT_TRUE(result.hasError());
+    EXPECT_FALSE(conn.isPrepared("test_stmt"));
+}
+
+TEST_F(ConnectionTest, StreamWithoutConnection) {
+    Connection conn;
+    
+    auto result = RowStream::open(conn, "SELECT 1");
+    
+    EXPECT_FALSE(result.hasValue());
+    EXPECT_TRUE(result.hasError());
+}
+
+TEST_F(ConnectionTest, CopyInWithoutConnection) {
+    Connection conn;
+    
+    auto result = conn.copyIn("COPY t FROM STDIN", "1\n");
+    
+    EXPECT_TRUE(result.hasError());
+}
+
+TEST_F(ConnectionTest, CopyFieldEscaping) {
+    std::string out;
+    pq::detail::appendCopyField(out, "a\tb\nc\\d\re");
+    EXPECT_EQ(out, "a\\tb\\nc\\\\d\\re");
+    
+    out.clear();
+    pq::detail::appendCopyField(out, "plain text");
+    EXPECT_EQ(out, "plain text");
+}
+
+TEST_F(ConnectionTest, NotificationsWithoutConnection) {
+    Connection conn;
+    
+    EXPECT_FALSE(conn.listen("events").hasValue());
+    EXPECT_FALSE(conn.unlisten("events").hasValue());
+    
+    auto result = conn.notifications(std::chrono::milliseconds(10));
+    ASSERT_TRUE(result.hasError());
+    EXPECT_EQ(result.error().message, "Not connected");
+}
+
 TEST_F(ConnectionTest, BeginTransactionWithoutConnection) {
     Connection conn;
     
@@ -211,6 +259,19 @@ TEST_F(ConnectionTest, RollbackWithoutConnection) {
     
     EXPECT_FALSE(result.hasValue());
     EXPECT_TRUE(result.hasError());
+    EXPECT_EQ(conn.rollbackCount(), 0u);  // Nothing was rolled back
+}
+
+TEST_F(ConnectionTest, AfterCommitOutsideTransactionRunsAtOnce) {
+    Connection conn;
+    int runs = 0;
+    
+    conn.afterCommit([&runs] { ++runs; });
+    EXPECT_EQ(runs, 1);
+    
+    // No transaction was open, so there is nothing left to run
+    (void)conn.commit();
+    EXPECT_EQ(runs, 1);
 }
 
 TEST_F(ConnectionTest, DisconnectSafe) {
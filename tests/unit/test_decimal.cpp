@@ -0,0 +1,179 @@
+/**
+ * @file test_decimal.cpp
+ * @brief Unit tests for the Decimal (NUMERIC) type
+ */
+
+#include <gtest/gtest.h>
+#include <pq/core/Decimal.hpp>
+#include <string>
+#include <vector>
+
+using namespace pq;
+
+class DecimalTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+    void TearDown() override {}
+    
+    // Build a binary NUMERIC value: ndigits, weight, sign, dscale, digits...
+    static std::string numericBinary(int16_t weight, uint16_t sign, uint16_t dscale,
+                                     const std::vector<uint16_t>& digits) {
+        std::string out;
+        auto put16 = [&out](uint16_t v) {
+            out.push_back(static_cast<char>(v >> 8));
+            out.push_back(static_cast<char>(v & 0xFF));
+        };
+        put16(static_cast<uint16_t>(digits.size()));
+        put16(static_cast<uint16_t>(weight));
+        put16(sign);
+        put16(dscale);
+        for (auto d : digits) {
+            put16(d);
+        }
+        return out;
+    }
+};
+
+TEST_F(DecimalTest, TypeTraits) {
+    EXPECT_EQ(PgTypeTraits<Decimal>::pgOid, oid::NUMERIC);
+    EXPECT_STREQ(PgTypeTraits<Decimal>::pgTypeName, "numeric");
+    EXPECT_FALSE(PgTypeTraits<Decimal>::isNullable);
+    EXPECT_TRUE(hasBinaryDecoderV<Decimal>);
+}
+
+TEST_F(DecimalTest, ParseAndFormatKeepsScale) {
+    EXPECT_EQ(Decimal::fromString("123.450").toString(), "123.450");
+    EXPECT_EQ(Decimal::fromString("-0.001").toString(), "-0.001");
+    EXPECT_EQ(Decimal::fromString("42").toString(), "42");
+    EXPECT_EQ(Decimal::fromString("  7.5 ").toString(), "7.5");
+    EXPECT_EQ(Decimal::fromString(".5").toString(), "0.5");
+    EXPECT_EQ(Decimal::fromString("1.5e3").toString(), "1500");
+    EXPECT_EQ(Decimal::fromString("15e-4").toString(), "0.0015");
+    EXPECT_EQ(Decimal::fromString("123.450").scale(), 3);
+}
+
+TEST_F(DecimalTest, ParseSpecialValues) {
+    EXPECT_TRUE(Decimal::fromString("NaN").isNaN());
+    EXPECT_EQ(Decimal::fromString("Infinity").kind(), Decimal::Kind::PositiveInfinity);
+    EXPECT_EQ(Decimal::fromString("-Infinity").kind(), Decimal::Kind::NegativeInfinity);
+    EXPECT_EQ(Decimal::fromString("-inf").toString(), "-Infinity");
+}
+
+TEST_F(DecimalTest, ParseRejectsMalformedInput) {
+    EXPECT_THROW(Decimal::fromString(""), std::invalid_argument);
+    EXPECT_THROW(Decimal::fromString("abc"), std::invalid_argument);
+    EXPECT_THROW(Decimal::fromString("1.2.3"), std::invalid_argument);
+    EXPECT_THROW(Decimal::fromString("1e"), std::invalid_argument);
+    EXPECT_THROW(Decimal::fromString("-"), std::invalid_argument);
+}
+
+TEST_F(DecimalTest, SumIsExact) {
+    Decimal total;
+    const Decimal cent = Decimal::fromString("0.01");
+    for (int i = 0; i < 100000; ++i) {
+        total += cent;
+    }
+    EXPECT_EQ(total.toString(), "1000.00");
+    EXPECT_TRUE(total.isCompact());
+}
+
+TEST_F(DecimalTest, MixedScaleArithmetic) {
+    const Decimal a = Decimal::fromString("1.5");
+    const Decimal b = Decimal::fromString("2.25");
+    
+    EXPECT_EQ((a + b).toString(), "3.75");
+    EXPECT_EQ((a - b).toString(), "-0.75");
+    EXPECT_EQ((a * b).toString(), "3.375");
+    EXPECT_EQ((-a).toString(), "-1.5");
+}
+
+TEST_F(DecimalTest, PromotesToArbitraryPrecision) {
+    const std::string big = "123456789012345678901234567890123456789.123";
+    Decimal a = Decimal::fromString(big);
+    EXPECT_FALSE(a.isCompact());
+    EXPECT_EQ(a.toString(), big);
+    
+    Decimal sum = a + Decimal::fromString("0.877");
+    EXPECT_EQ(sum.toString(), "123456789012345678901234567890123456790.000");
+    
+    // Results that fit again are stored compactly
+    Decimal back = sum - a;
+    EXPECT_EQ(back.toString(), "0.877");
+    EXPECT_TRUE(back.isCompact());
+}
+
+TEST_F(DecimalTest, CompactOverflowOnAddition) {
+    const Decimal nines = Decimal::fromString(std::string(36, '9'));
+    ASSERT_TRUE(nines.isCompact());
+    
+    Decimal sum = nines + Decimal(1);
+    EXPECT_EQ(sum.toString(), "1" + std::string(36, '0'));
+    
+    Decimal product = nines * nines;
+    EXPECT_EQ(product.toString(), std::string(35, '9') + "8" + std::string(35, '0') + "1");
+}
+
+TEST_F(DecimalTest, CompareIgnoresScale) {
+    EXPECT_EQ(Decimal::fromString("1.10"), Decimal::fromString("1.1"));
+    EXPECT_LT(Decimal::fromString("-2"), Decimal::fromString("1.5"));
+    EXPECT_GT(Decimal::fromString("1" + std::string(50, '0')), Decimal::fromString("9.99"));
+    EXPECT_LT(Decimal::infinity(true), Decimal(0));
+    EXPECT_GT(Decimal::nan(), Decimal::infinity());
+    EXPECT_EQ(Decimal::nan(), Decimal::nan());
+}
+
+TEST_F(DecimalTest, RescaleRoundsHalfAwayFromZero) {
+    EXPECT_EQ(Decimal::fromString("2.345").rescale(2).toString(), "2.35");
+    EXPECT_EQ(Decimal::fromString("-2.345").rescale(2).toString(), "-2.35");
+    EXPECT_EQ(Decimal::fromString("2.344").rescale(2).toString(), "2.34");
+    EXPECT_EQ(Decimal::fromString("2.5").rescale(4).toString(), "2.5000");
+    
+    const Decimal big = Decimal::fromString(std::string(40, '1') + ".55");
+    EXPECT_EQ(big.rescale(1).toString(), std::string(40, '1') + ".6");
+}
+
+TEST_F(DecimalTest, SpecialValueArithmetic) {
+    EXPECT_TRUE((Decimal::nan() + Decimal(1)).isNaN());
+    EXPECT_TRUE((Decimal::infinity() - Decimal::infinity()).isNaN());
+    EXPECT_TRUE((Decimal::infinity() * Decimal(0)).isNaN());
+    EXPECT_EQ((Decimal::infinity() * Decimal(-2)).kind(), Decimal::Kind::NegativeInfinity);
+}
+
+TEST_F(DecimalTest, FromScaledAndToDouble) {
+    EXPECT_EQ(Decimal::fromScaled(1234, 2).toString(), "12.34");
+    EXPECT_EQ(Decimal::fromScaled(-5, 3).toString(), "-0.005");
+    EXPECT_DOUBLE_EQ(Decimal::fromString("12.34").toDouble(), 12.34);
+    EXPECT_THROW(Decimal::fromScaled(1, -1), std::invalid_argument);
+}
+
+TEST_F(DecimalTest, DecodeBinary) {
+    // 12345.678 = [1, 2345, 6780] * 10000^(1 - i), dscale 3
+    auto bin = numericBinary(1, 0x0000, 3, {1, 2345, 6780});
+    Decimal d = PgTypeTraits<Decimal>::fromBinary(bin.data(), static_cast<int>(bin.size()));
+    EXPECT_EQ(d.toString(), "12345.678");
+    
+    bin = numericBinary(-1, 0x4000, 1, {5000});
+    EXPECT_EQ(Decimal::fromBinary(bin.data(), static_cast<int>(bin.size())).toString(), "-0.5");
+    
+    bin = numericBinary(0, 0x0000, 2, {});
+    EXPECT_EQ(Decimal::fromBinary(bin.data(), static_cast<int>(bin.size())).toString(), "0.00");
+    
+    bin = numericBinary(10, 0x0000, 0, {1});
+    EXPECT_EQ(Decimal::fromBinary(bin.data(), static_cast<int>(bin.size())).toString(),
+              "1" + std::string(40, '0'));
+}
+
+TEST_F(DecimalTest, DecodeBinarySpecialValues) {
+    auto bin = numericBinary(0, 0xC000, 0, {});
+    EXPECT_TRUE(Decimal::fromBinary(bin.data(), static_cast<int>(bin.size())).isNaN());
+    
+    bin = numericBinary(0, 0xF000, 0, {});
+    EXPECT_EQ(Decimal::fromBinary(bin.data(), static_cast<int>(bin.size())).kind(),
+              Decimal::Kind::NegativeInfinity);
+}
+
+TEST_F(DecimalTest, DecodeBinaryRejectsMalformedInput) {
+    auto bin = numericBinary(0, 0x0000, 0, {1, 2});
+    EXPECT_THROW(Decimal::fromBinary(bin.data(), 10), std::runtime_error);
+    EXPECT_THROW(Decimal::fromBinary(bin.data(), 4), std::runtime_error);
+}
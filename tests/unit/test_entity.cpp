@@ -7,6 +7,8 @@
 #include <pq/orm/Entity.hpp>
 #include <string>
 #include <optional>
+#include <thread>
+#include <vector>
 
 using namespace pq;
 using namespace pq::orm;
@@ -43,6 +45,172 @@ struct TestProduct {
 
 PQ_REGISTER_ENTITY(TestProduct)
 
+// Touched only by the concurrent first-use test
+struct TestFirstUse {
+    int64_t id{0};
+    std::string label;
+    
+    PQ_ENTITY(TestFirstUse, "test_first_use")
+        PQ_COLUMN(id, "id", PQ_PRIMARY_KEY)
+        PQ_COLUMN(label, "label")
+    PQ_ENTITY_END()
+};
+
+PQ_REGISTER_ENTITY(TestFirstUse)
+
+// Wide enough that a single-seed perfect hash table cannot be found
+struct TestWideEntity {
+    int64_t id{0};
+    int c01{0};
+    int c02{0};
+    int c03{0};
+    int c04{0};
+    int c05{0};
+    int c06{0};
+    int c07{0};
+    int c08{0};
+    int c09{0};
+    int c10{0};
+    int c11{0};
+    int c12{0};
+    int c13{0};
+    int c14{0};
+    int c15{0};
+    int c16{0};
+    int c17{0};
+    int c18{0};
+    int c19{0};
+    int c20{0};
+    int c21{0};
+    int c22{0};
+    int c23{0};
+    int c24{0};
+    int c25{0};
+    int c26{0};
+    int c27{0};
+    int c28{0};
+    int c29{0};
+    int c30{0};
+    int c31{0};
+    int c32{0};
+    int c33{0};
+    int c34{0};
+    int c35{0};
+    int c36{0};
+    int c37{0};
+    int c38{0};
+    int c39{0};
+    int c40{0};
+    int c41{0};
+    int c42{0};
+    int c43{0};
+    int c44{0};
+    int c45{0};
+    int c46{0};
+    int c47{0};
+    int c48{0};
+    int c49{0};
+    int c50{0};
+    int c51{0};
+    int c52{0};
+    int c53{0};
+    int c54{0};
+    int c55{0};
+    int c56{0};
+    int c57{0};
+    int c58{0};
+    int c59{0};
+    int c60{0};
+    int c61{0};
+    int c62{0};
+    int c63{0};
+    int c64{0};
+    int c65{0};
+    int c66{0};
+    int c67{0};
+    int c68{0};
+    int c69{0};
+    int c70{0};
+    int c71{0};
+    
+    PQ_ENTITY(TestWideEntity, "test_wide")
+        PQ_COLUMN(id, "id", PQ_PRIMARY_KEY)
+        PQ_COLUMN(c01, "column_01")
+        PQ_COLUMN(c02, "column_02")
+        PQ_COLUMN(c03, "column_03")
+        PQ_COLUMN(c04, "column_04")
+        PQ_COLUMN(c05, "column_05")
+        PQ_COLUMN(c06, "column_06")
+        PQ_COLUMN(c07, "column_07")
+        PQ_COLUMN(c08, "column_08")
+        PQ_COLUMN(c09, "column_09")
+        PQ_COLUMN(c10, "column_10")
+        PQ_COLUMN(c11, "column_11")
+        PQ_COLUMN(c12, "column_12")
+        PQ_COLUMN(c13, "column_13")
+        PQ_COLUMN(c14, "column_14")
+        PQ_COLUMN(c15, "column_15")
+        PQ_COLUMN(c16, "column_16")
+        PQ_COLUMN(c17, "column_17")
+        PQ_COLUMN(c18, "column_18")
+        PQ_COLUMN(c19, "column_19")
+        PQ_COLUMN(c20, "column_20")
+        PQ_COLUMN(c21, "column_21")
+        PQ_COLUMN(c22, "column_22")
+        PQ_COLUMN(c23, "column_23")
+        PQ_COLUMN(c24, "column_24")
+        PQ_COLUMN(c25, "column_25")
+        PQ_COLUMN(c26, "column_26")
+        PQ_COLUMN(c27, "column_27")
+        PQ_COLUMN(c28, "column_28")
+        PQ_COLUMN(c29, "column_29")
+        PQ_COLUMN(c30, "column_30")
+        PQ_COLUMN(c31, "column_31")
+        PQ_COLUMN(c32, "column_32")
+        PQ_COLUMN(c33, "column_33")
+        PQ_COLUMN(c34, "column_34")
+        PQ_COLUMN(c35, "column_35")
+        PQ_COLUMN(c36, "column_36")
+        PQ_COLUMN(c37, "column_37")
+        PQ_COLUMN(c38, "column_38")
+        PQ_COLUMN(c39, "column_39")
+        PQ_COLUMN(c40, "column_40")
+        PQ_COLUMN(c41, "column_41")
+        PQ_COLUMN(c42, "column_42")
+        PQ_COLUMN(c43, "column_43")
+        PQ_COLUMN(c44, "column_44")
+        PQ_COLUMN(c45, "column_45")
+        PQ_COLUMN(c46, "column_46")
+        PQ_COLUMN(c47, "column_47")
+        PQ_COLUMN(c48, "column_48")
+        PQ_COLUMN(c49, "column_49")
+        PQ_COLUMN(c50, "column_50")
+        PQ_COLUMN(c51, "column_51")
+        PQ_COLUMN(c52, "column_52")
+        PQ_COLUMN(c53, "column_53")
+        PQ_COLUMN(c54, "column_54")
+        PQ_COLUMN(c55, "column_55")
+        PQ_COLUMN(c56, "column_56")
+        PQ_COLUMN(c57, "column_57")
+        PQ_COLUMN(c58, "column_58")
+        PQ_COLUMN(c59, "column_59")
+        PQ_COLUMN(c60, "column_60")
+        PQ_COLUMN(c61, "column_61")
+        PQ_COLUMN(c62, "column_62")
+        PQ_COLUMN(c63, "column_63")
+        PQ_COLUMN(c64, "column_64")
+        PQ_COLUMN(c65, "column_65")
+        PQ_COLUMN(c66, "column_66")
+        PQ_COLUMN(c67, "column_67")
+        PQ_COLUMN(c68, "column_68")
+        PQ_COLUMN(c69, "column_69")
+        PQ_COLUMN(c70, "column_70")
+        PQ_COLUMN(c71, "column_71")
+    PQ_ENTITY_END()
+};
+
+PQ_REGISTER_ENTITY(TestWideEntity)
+
 class EntityTest : public ::testing::Test {
 protected:
     void SetUp() override {}
@@ -208,6 +376,71 @@ TEST_F(EntityTest, FindColumnByName) {
     EXPECT_EQ(nonExistent, nullptr);
 }
 
+TEST_F(EntityTest, StaticColumnTuple) {
+    static_assert(columnCountV<TestUser> == 3);
+    static_assert(std::get<0>(EntityMeta<TestUser>::columns).columnName == "id");
+    static_assert(std::get<0>(EntityMeta<TestUser>::columns).isPrimaryKey());
+    static_assert(!std::get<2>(EntityMeta<TestUser>::columns).isAutoIncrement());
+    static_assert(std::get<2>(EntityMeta<TestUser>::columns).isNullable);
+    
+    TestUser user;
+    user.id = 7;
+    std::vector<std::string> names;
+    forEachColumn<TestUser>([&](const auto& col) {
+        names.emplace_back(col.columnName);
+        if (col.isPrimaryKey()) {
+            EXPECT_EQ(col.toString(user), "7");
+        }
+    });
+    EXPECT_EQ(names, (std::vector<std::string>{"id", "name", "email"}));
+}
+
+TEST_F(EntityTest, ConstexprColumnTable) {
+    constexpr const auto& table = EntityMeta<TestProduct>::columnTable;
+    static_assert(table.columns.size() == 4);
+    static_assert(table.columns[3].columnName == "is_active");
+    static_assert(table.columns[2].pgType == oid::FLOAT8);
+    static_assert(table.primaryKey == 0);
+    static_assert(table.find("price") == 2);
+    static_assert(table.find("active") == -1);  // Field name, not column name
+    
+    EXPECT_EQ(findColumnIndex<TestProduct>("is_active"), 3);
+    EXPECT_EQ(EntityMeta<TestProduct>::metadata().findColumn("is_active")->info.fieldName, "active");
+}
+
+TEST_F(EntityTest, WideEntityColumnTable) {
+    static constexpr auto table = TestWideEntity::_pqColumnTable();
+    static_assert(table.columns.size() == 72);
+    static_assert(table.find("id") == 0);
+    static_assert(table.find("column_71") == 71);
+    
+    for (int i = 1; i < 72; ++i) {
+        const std::string name = (i < 10 ? "column_0" : "column_") + std::to_string(i);
+        EXPECT_EQ(findColumnIndex<TestWideEntity>(name), i) << name;
+    }
+    EXPECT_EQ(findColumnIndex<TestWideEntity>("column_72"), -1);
+    EXPECT_EQ(table.primaryKey, 0);
+}
+
+TEST_F(EntityTest, ConcurrentFirstUse) {
+    std::vector<std::thread> threads;
+    std::vector<const void*> seen(16);
+    for (size_t i = 0; i < seen.size(); ++i) {
+        threads.emplace_back([&seen, i] {
+            const auto& meta = EntityMeta<TestFirstUse>::metadata();
+            seen[i] = &meta;
+            EXPECT_EQ(meta.columns().size(), 2u);
+            EXPECT_NE(meta.findColumn("label"), nullptr);
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    for (const void* meta : seen) {
+        EXPECT_EQ(meta, seen[0]);
+    }
+}
+
 TEST_F(EntityTest, MultipleTypeSupport) {
     TestProduct product;
     product.id = 12345678901234LL;
@@ -0,0 +1,218 @@
+/**
+ * @file test_enum.cpp
+ * @brief Unit tests for PostgreSQL ENUM mapping
+ */
+
+#include <gtest/gtest.h>
+#include <pq/core/Enum.hpp>
+#include <pq/core/Array.hpp>
+#include <string>
+#include <vector>
+
+namespace shop {
+
+enum class OrderStatus { Pending, Shipped, Delivered, Cancelled, Returned };
+
+enum class Permission : uint32_t { Read = 1, Write = 1u << 10, Admin = 1u << 20 };
+
+// More labels than a single-seed perfect hash table could take
+enum class Zone { Z00, Z01, Z02, Z03, Z04, Z05, Z06, Z07, Z08, Z09, Z10, Z11, Z12, Z13, Z14, Z15, Z16, Z17, Z18, Z19, Z20, Z21, Z22, Z23, Z24, Z25, Z26, Z27, Z28, Z29, Z30, Z31, Z32, Z33, Z34, Z35, Z36, Z37, Z38, Z39, Z40, Z41, Z42, Z43, Z44, Z45, Z46, Z47, Z48, Z49, Z50, Z51, Z52, Z53, Z54, Z55, Z56, Z57, Z58, Z59, Z60, Z61, Z62, Z63, Z64, Z65, Z66, Z67, Z68, Z69, Z70, Z71, Z72, Z73, Z74, Z75, Z76, Z77, Z78, Z79, Z80, Z81, Z82, Z83, Z84, Z85, Z86, Z87, Z88, Z89, Z90, Z91, Z92, Z93, Z94, Z95 };
+
+} // namespace shop
+
+PQ_ENUM(shop::OrderStatus, "order_status",
+    PQ_ENUM_VALUE(shop::OrderStatus::Pending, "pending"),
+    PQ_ENUM_VALUE(shop::OrderStatus::Shipped, "shipped"),
+    PQ_ENUM_VALUE(shop::OrderStatus::Delivered, "delivered"),
+    PQ_ENUM_VALUE(shop::OrderStatus::Cancelled, "cancelled"),
+    PQ_ENUM_VALUE(shop::OrderStatus::Returned, "returned"))
+
+PQ_ENUM(shop::Permission, "permission",
+    PQ_ENUM_VALUE(shop::Permission::Admin, "admin"),
+    PQ_ENUM_VALUE(shop::Permission::Read, "read"),
+    PQ_ENUM_VALUE(shop::Permission::Write, "write"))
+
+PQ_ENUM(shop::Zone, "zone",
+    PQ_ENUM_VALUE(shop::Zone::Z00, "zone_00"),
+    PQ_ENUM_VALUE(shop::Zone::Z01, "zone_01"),
+    PQ_ENUM_VALUE(shop::Zone::Z02, "zone_02"),
+    PQ_ENUM_VALUE(shop::Zone::Z03, "zone_03"),
+    PQ_ENUM_VALUE(shop::Zone::Z04, "zone_04"),
+    PQ_ENUM_VALUE(shop::Zone::Z05, "zone_05"),
+    PQ_ENUM_VALUE(shop::Zone::Z06, "zone_06"),
+    PQ_ENUM_VALUE(shop::Zone::Z07, "zone_07"),
+    PQ_ENUM_VALUE(shop::Zone::Z08, "zone_08"),
+    PQ_ENUM_VALUE(shop::Zone::Z09, "zone_09"),
+    PQ_ENUM_VALUE(shop::Zone::Z10, "zone_10"),
+    PQ_ENUM_VALUE(shop::Zone::Z11, "zone_11"),
+    PQ_ENUM_VALUE(shop::Zone::Z12, "zone_12"),
+    PQ_ENUM_VALUE(shop::Zone::Z13, "zone_13"),
+    PQ_ENUM_VALUE(shop::Zone::Z14, "zone_14"),
+    PQ_ENUM_VALUE(shop::Zone::Z15, "zone_15"),
+    PQ_ENUM_VALUE(shop::Zone::Z16, "zone_16"),
+    PQ_ENUM_VALUE(shop::Zone::Z17, "zone_17"),
+    PQ_ENUM_VALUE(shop::Zone::Z18, "zone_18"),
+    PQ_ENUM_VALUE(shop::Zone::Z19, "zone_19"),
+    PQ_ENUM_VALUE(shop::Zone::Z20, "zone_20"),
+    PQ_ENUM_VALUE(shop::Zone::Z21, "zone_21"),
+    PQ_ENUM_VALUE(shop::Zone::Z22, "zone_22"),
+    PQ_ENUM_VALUE(shop::Zone::Z23, "zone_23"),
+    PQ_ENUM_VALUE(shop::Zone::Z24, "zone_24"),
+    PQ_ENUM_VALUE(shop::Zone::Z25, "zone_25"),
+    PQ_ENUM_VALUE(shop::Zone::Z26, "zone_26"),
+    PQ_ENUM_VALUE(shop::Zone::Z27, "zone_27"),
+    PQ_ENUM_VALUE(shop::Zone::Z28, "zone_28"),
+    PQ_ENUM_VALUE(shop::Zone::Z29, "zone_29"),
+    PQ_ENUM_VALUE(shop::Zone::Z30, "zone_30"),
+    PQ_ENUM_VALUE(shop::Zone::Z31, "zone_31"),
+    PQ_ENUM_VALUE(shop::Zone::Z32, "zone_32"),
+    PQ_ENUM_VALUE(shop::Zone::Z33, "zone_33"),
+    PQ_ENUM_VALUE(shop::Zone::Z34, "zone_34"),
+    PQ_ENUM_VALUE(shop::Zone::Z35, "zone_35"),
+    PQ_ENUM_VALUE(shop::Zone::Z36, "zone_36"),
+    PQ_ENUM_VALUE(shop::Zone::Z37, "zone_37"),
+    PQ_ENUM_VALUE(shop::Zone::Z38, "zone_38"),
+    PQ_ENUM_VALUE(shop::Zone::Z39, "zone_39"),
+    PQ_ENUM_VALUE(shop::Zone::Z40, "zone_40"),
+    PQ_ENUM_VALUE(shop::Zone::Z41, "zone_41"),
+    PQ_ENUM_VALUE(shop::Zone::Z42, "zone_42"),
+    PQ_ENUM_VALUE(shop::Zone::Z43, "zone_43"),
+    PQ_ENUM_VALUE(shop::Zone::Z44, "zone_44"),
+    PQ_ENUM_VALUE(shop::Zone::Z45, "zone_45"),
+    PQ_ENUM_VALUE(shop::Zone::Z46, "zone_46"),
+    PQ_ENUM_VALUE(shop::Zone::Z47, "zone_47"),
+    PQ_ENUM_VALUE(shop::Zone::Z48, "zone_48"),
+    PQ_ENUM_VALUE(shop::Zone::Z49, "zone_49"),
+    PQ_ENUM_VALUE(shop::Zone::Z50, "zone_50"),
+    PQ_ENUM_VALUE(shop::Zone::Z51, "zone_51"),
+    PQ_ENUM_VALUE(shop::Zone::Z52, "zone_52"),
+    PQ_ENUM_VALUE(shop::Zone::Z53, "zone_53"),
+    PQ_ENUM_VALUE(shop::Zone::Z54, "zone_54"),
+    PQ_ENUM_VALUE(shop::Zone::Z55, "zone_55"),
+    PQ_ENUM_VALUE(shop::Zone::Z56, "zone_56"),
+    PQ_ENUM_VALUE(shop::Zone::Z57, "zone_57"),
+    PQ_ENUM_VALUE(shop::Zone::Z58, "zone_58"),
+    PQ_ENUM_VALUE(shop::Zone::Z59, "zone_59"),
+    PQ_ENUM_VALUE(shop::Zone::Z60, "zone_60"),
+    PQ_ENUM_VALUE(shop::Zone::Z61, "zone_61"),
+    PQ_ENUM_VALUE(shop::Zone::Z62, "zone_62"),
+    PQ_ENUM_VALUE(shop::Zone::Z63, "zone_63"),
+    PQ_ENUM_VALUE(shop::Zone::Z64, "zone_64"),
+    PQ_ENUM_VALUE(shop::Zone::Z65, "zone_65"),
+    PQ_ENUM_VALUE(shop::Zone::Z66, "zone_66"),
+    PQ_ENUM_VALUE(shop::Zone::Z67, "zone_67"),
+    PQ_ENUM_VALUE(shop::Zone::Z68, "zone_68"),
+    PQ_ENUM_VALUE(shop::Zone::Z69, "zone_69"),
+    PQ_ENUM_VALUE(shop::Zone::Z70, "zone_70"),
+    PQ_ENUM_VALUE(shop::Zone::Z71, "zone_71"),
+    PQ_ENUM_VALUE(shop::Zone::Z72, "zone_72"),
+    PQ_ENUM_VALUE(shop::Zone::Z73, "zone_73"),
+    PQ_ENUM_VALUE(shop::Zone::Z74, "zone_74"),
+    PQ_ENUM_VALUE(shop::Zone::Z75, "zone_75"),
+    PQ_ENUM_VALUE(shop::Zone::Z76, "zone_76"),
+    PQ_ENUM_VALUE(shop::Zone::Z77, "zone_77"),
+    PQ_ENUM_VALUE(shop::Zone::Z78, "zone_78"),
+    PQ_ENUM_VALUE(shop::Zone::Z79, "zone_79"),
+    PQ_ENUM_VALUE(shop::Zone::Z80, "zone_80"),
+    PQ_ENUM_VALUE(shop::Zone::Z81, "zone_81"),
+    PQ_ENUM_VALUE(shop::Zone::Z82, "zone_82"),
+    PQ_ENUM_VALUE(shop::Zone::Z83, "zone_83"),
+    PQ_ENUM_VALUE(shop::Zone::Z84, "zone_84"),
+    PQ_ENUM_VALUE(shop::Zone::Z85, "zone_85"),
+    PQ_ENUM_VALUE(shop::Zone::Z86, "zone_86"),
+    PQ_ENUM_VALUE(shop::Zone::Z87, "zone_87"),
+    PQ_ENUM_VALUE(shop::Zone::Z88, "zone_88"),
+    PQ_ENUM_VALUE(shop::Zone::Z89, "zone_89"),
+    PQ_ENUM_VALUE(shop::Zone::Z90, "zone_90"),
+    PQ_ENUM_VALUE(shop::Zone::Z91, "zone_91"),
+    PQ_ENUM_VALUE(shop::Zone::Z92, "zone_92"),
+    PQ_ENUM_VALUE(shop::Zone::Z93, "zone_93"),
+    PQ_ENUM_VALUE(shop::Zone::Z94, "zone_94"),
+    PQ_ENUM_VALUE(shop::Zone::Z95, "zone_95"))
+
+using namespace pq;
+using shop::OrderStatus;
+using shop::Permission;
+
+class EnumTest : public ::testing::Test {
+protected:
+    using StatusTraits = PgTypeTraits<OrderStatus>;
+};
+
+TEST_F(EnumTest, TypeTraits) {
+    EXPECT_STREQ(StatusTraits::pgTypeName, "order_status");
+    EXPECT_STREQ(StatusTraits::pgArrayTypeName, "order_status[]");
+    EXPECT_EQ(StatusTraits::pgOid, 0u);  // Assigned per database
+    EXPECT_EQ(StatusTraits::maxTextLength, 9u);
+    EXPECT_TRUE(hasEnumMappingV<OrderStatus>);
+    EXPECT_FALSE(hasEnumMappingV<int>);
+    EXPECT_TRUE(hasBinaryDecoderV<OrderStatus>);
+    EXPECT_TRUE(hasFormatToV<OrderStatus>);
+}
+
+TEST_F(EnumTest, LookupsAreConstantExpressions) {
+    static_assert(detail::EnumIndex<OrderStatus>::find("shipped")->value == OrderStatus::Shipped);
+    static_assert(detail::EnumIndex<OrderStatus>::find("unknown") == nullptr);
+    static_assert(detail::EnumIndex<OrderStatus>::label(OrderStatus::Returned) == "returned");
+    static_assert(detail::EnumIndex<OrderStatus>::dense);
+    static_assert(!detail::EnumIndex<Permission>::dense);
+}
+
+TEST_F(EnumTest, TextRoundTrip) {
+    for (auto status : {OrderStatus::Pending, OrderStatus::Shipped, OrderStatus::Delivered,
+                        OrderStatus::Cancelled, OrderStatus::Returned}) {
+        const std::string text = StatusTraits::toString(status);
+        EXPECT_EQ(StatusTraits::fromString(text.c_str()), status);
+    }
+    EXPECT_EQ(StatusTraits::toString(OrderStatus::Cancelled), "cancelled");
+}
+
+TEST_F(EnumTest, SparseValues) {
+    EXPECT_EQ(PgTypeTraits<Permission>::toString(Permission::Admin), "admin");
+    EXPECT_EQ(PgTypeTraits<Permission>::fromString("write"), Permission::Write);
+    EXPECT_THROW((void)PgTypeTraits<Permission>::toString(static_cast<Permission>(3)),
+                 std::invalid_argument);
+}
+
+TEST_F(EnumTest, RejectsUnknownLabels) {
+    EXPECT_THROW((void)StatusTraits::fromString("Pending"), std::invalid_argument);
+    EXPECT_THROW((void)StatusTraits::fromString("pend"), std::invalid_argument);
+    EXPECT_THROW((void)StatusTraits::fromString(""), std::invalid_argument);
+    EXPECT_THROW((void)StatusTraits::toString(static_cast<OrderStatus>(42)),
+                 std::invalid_argument);
+    
+    // Not written as an empty text, which would bind NULL
+    char buf[StatusTraits::maxTextLength];
+    EXPECT_THROW((void)StatusTraits::formatTo(static_cast<OrderStatus>(42), buf, sizeof(buf)),
+                 std::invalid_argument);
+    EXPECT_THROW(ParamConverter<OrderStatus>(static_cast<OrderStatus>(42)), std::invalid_argument);
+}
+
+TEST_F(EnumTest, ManyLabels) {
+    static_assert(detail::EnumIndex<shop::Zone>::find("zone_95")->value == shop::Zone::Z95);
+    static_assert(detail::EnumIndex<shop::Zone>::find("zone_96") == nullptr);
+    
+    for (int i = 0; i < 96; ++i) {
+        const auto zone = static_cast<shop::Zone>(i);
+        EXPECT_EQ(PgTypeTraits<shop::Zone>::fromString(PgTypeTraits<shop::Zone>::toString(zone).c_str()),
+                  zone);
+    }
+}
+
+TEST_F(EnumTest, BinaryFormatIsTheLabel) {
+    const char wire[] = {'d', 'e', 'l', 'i', 'v', 'e', 'r', 'e', 'd'};
+    EXPECT_EQ(decodeValue<OrderStatus>(wire, sizeof(wire), Format::Binary),
+              OrderStatus::Delivered);
+    EXPECT_THROW((void)StatusTraits::fromBinary(wire, 4), std::invalid_argument);
+}
+
+TEST_F(EnumTest, ParamsAndArrays) {
+    ParamConverter<OrderStatus> conv(OrderStatus::Shipped);
+    EXPECT_STREQ(conv.ptr, "shipped");
+    EXPECT_EQ(conv.type, 0u);
+    
+    const std::vector<OrderStatus> statuses = {OrderStatus::Pending, OrderStatus::Returned};
+    const std::string text = PgTypeTraits<std::vector<OrderStatus>>::toString(statuses);
+    EXPECT_EQ(text, "{pending,returned}");
+    EXPECT_EQ(PgTypeTraits<std::vector<OrderStatus>>::fromString(text.c_str()), statuses);
+}
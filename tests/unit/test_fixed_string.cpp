@@ -0,0 +1,86 @@
+/**
+ * @file test_fixed_string.cpp
+ * @brief Unit tests for the inline FixedString type
+ */
+
+#include <gtest/gtest.h>
+#include <pq/core/FixedString.hpp>
+#include <pq/core/Array.hpp>
+#include <string>
+#include <type_traits>
+#include <unordered_set>
+#include <vector>
+
+using namespace pq;
+
+class FixedStringTest : public ::testing::Test {
+protected:
+    using Sku = FixedString<8>;
+    using Code = FixedString<4, Overflow::Truncate>;
+};
+
+TEST_F(FixedStringTest, StorageIsInline) {
+    EXPECT_TRUE(std::is_trivially_copyable_v<Sku>);
+    EXPECT_TRUE(std::is_trivially_copyable_v<FixedString<300>>);
+    EXPECT_EQ(sizeof(FixedString<22>), 24u);  // 22 bytes, terminator, length
+    
+    constexpr FixedString<4> code("KR");
+    static_assert(code.size() == 2);
+    static_assert(code == "KR");
+}
+
+TEST_F(FixedStringTest, TypeTraits) {
+    EXPECT_EQ(PgTypeTraits<Sku>::pgOid, oid::TEXT);
+    EXPECT_EQ(PgTypeTraits<Sku>::maxTextLength, 8u);
+    EXPECT_TRUE(hasBinaryDecoderV<Sku>);
+    EXPECT_TRUE(hasFormatToV<Sku>);
+    EXPECT_EQ(PgTypeTraits<std::vector<Sku>>::pgOid, oid::TEXT_ARRAY);
+}
+
+TEST_F(FixedStringTest, ThrowsOnOverflowByDefault) {
+    const Sku exact("ABCD-123");
+    EXPECT_EQ(exact.view(), "ABCD-123");
+    EXPECT_STREQ(exact.c_str(), "ABCD-123");
+    
+    EXPECT_THROW(Sku("ABCD-1234"), std::length_error);
+    EXPECT_THROW((void)PgTypeTraits<Sku>::fromString("ABCD-1234"), std::length_error);
+}
+
+TEST_F(FixedStringTest, TruncatePolicy) {
+    EXPECT_EQ(Code("KR-SEOUL"), "KR-S");
+    EXPECT_EQ(PgTypeTraits<Code>::fromString("US-NYC"), "US-N");
+    
+    // Never splits a UTF-8 sequence: "a" + two 3-byte characters
+    EXPECT_EQ(Code("a\xED\x95\x9C\xEA\xB8\x80"), "a\xED\x95\x9C");
+    EXPECT_EQ(Sku::truncate("ABCD-12345"), "ABCD-123");
+}
+
+TEST_F(FixedStringTest, TextAndBinaryDecoding) {
+    EXPECT_EQ(PgTypeTraits<Sku>::fromString(""), "");
+    EXPECT_TRUE(PgTypeTraits<Sku>::fromString("").empty());
+    
+    const char wire[] = {'S', 'K', 'U', '\0', '1'};
+    const Sku fromWire = decodeValue<Sku>(wire, 3, Format::Binary);
+    EXPECT_EQ(fromWire, "SKU");
+    EXPECT_EQ(PgTypeTraits<Sku>::toBinary(fromWire), "SKU");
+}
+
+TEST_F(FixedStringTest, ParamsAndArrays) {
+    ParamConverter<Sku> conv(Sku("X-1"));
+    EXPECT_STREQ(conv.ptr, "X-1");
+    EXPECT_TRUE(conv.value.empty());
+    
+    const std::vector<Sku> skus = {Sku("A 1"), Sku("B")};
+    const std::string text = PgTypeTraits<std::vector<Sku>>::toString(skus);
+    EXPECT_EQ(text, "{\"A 1\",B}");
+    EXPECT_EQ(PgTypeTraits<std::vector<Sku>>::fromString(text.c_str()), skus);
+}
+
+TEST_F(FixedStringTest, ComparisonAndHash) {
+    EXPECT_LT(Sku("A"), Sku("B"));
+    EXPECT_EQ(Sku("A"), std::string("A"));
+    EXPECT_NE(Sku("A"), "B");
+    
+    std::unordered_set<Sku> set = {Sku("A"), Sku("B"), Sku("A")};
+    EXPECT_EQ(set.size(), 2u);
+}
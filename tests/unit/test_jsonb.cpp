@@ -0,0 +1,123 @@
+/**
+ * @file test_jsonb.cpp
+ * @brief Unit tests for the lazy Jsonb type
+ */
+
+#include <gtest/gtest.h>
+#include <pq/core/Jsonb.hpp>
+#include <pq/core/Array.hpp>
+#include <string>
+#include <vector>
+
+using namespace pq;
+
+class JsonbTest : public ::testing::Test {
+protected:
+    const Jsonb doc{R"({
+        "id": 42,
+        "name": "Alice \"A\" Smith",
+        "active": true,
+        "score": -1.5e2,
+        "tags": ["admin", "ops", "a,b]c"],
+        "nested": {"deep": {"value": null}, "text": "}{"},
+        "escApe": "café 😀",
+        "empty": {}
+    })"};
+};
+
+TEST_F(JsonbTest, TypeTraits) {
+    EXPECT_EQ(PgTypeTraits<Jsonb>::pgOid, oid::JSONB);
+    EXPECT_STREQ(PgTypeTraits<Jsonb>::pgTypeName, "jsonb");
+    EXPECT_TRUE(hasBinaryDecoderV<Jsonb>);
+    EXPECT_EQ(PgTypeTraits<std::vector<Jsonb>>::pgOid, oid::JSONB_ARRAY);
+}
+
+TEST_F(JsonbTest, KeepsRawText) {
+    const std::string text = R"({"b": 1, "a": [1, 2]})";
+    const Jsonb value = PgTypeTraits<Jsonb>::fromString(text.c_str());
+    EXPECT_EQ(value.text(), text);
+    EXPECT_EQ(PgTypeTraits<Jsonb>::toString(value), text);
+}
+
+TEST_F(JsonbTest, BinaryFormat) {
+    const std::string wire = std::string(1, '\x01') + R"({"k": "v"})";
+    const Jsonb value = decodeValue<Jsonb>(wire.data(), static_cast<int>(wire.size()),
+                                           Format::Binary);
+    EXPECT_EQ(value.text(), R"({"k": "v"})");
+    EXPECT_EQ(value["k"].asString(), "v");
+    EXPECT_EQ(PgTypeTraits<Jsonb>::toBinary(value), wire);
+    
+    const std::string future = std::string(1, '\x02') + "{}";
+    EXPECT_THROW(Jsonb::fromBinary(future.data(), static_cast<int>(future.size())),
+                 std::runtime_error);
+    EXPECT_THROW(Jsonb::fromBinary(future.data(), 0), std::runtime_error);
+}
+
+TEST_F(JsonbTest, ScalarAccess) {
+    EXPECT_EQ(doc["id"].asInt64(), 42);
+    EXPECT_EQ(doc["name"].asString(), "Alice \"A\" Smith");
+    EXPECT_TRUE(doc["active"].asBool());
+    EXPECT_DOUBLE_EQ(doc["score"].asDouble(), -150.0);
+    EXPECT_EQ(doc["id"].type(), JsonView::Type::Number);
+    EXPECT_EQ(doc["name"].type(), JsonView::Type::String);
+}
+
+TEST_F(JsonbTest, NestedNavigation) {
+    EXPECT_TRUE(doc["nested"]["deep"]["value"].isNull());
+    EXPECT_EQ(doc["nested"]["text"].asString(), "}{");
+    EXPECT_EQ(doc["tags"][1].asString(), "ops");
+    EXPECT_EQ(doc["tags"][2].asString(), "a,b]c");
+    EXPECT_EQ(doc["tags"].size(), 3u);
+    EXPECT_EQ(doc["empty"].size(), 0u);
+    EXPECT_EQ(doc["nested"]["deep"].raw(), R"({"value": null})");
+}
+
+TEST_F(JsonbTest, UnicodeEscapes) {
+    EXPECT_EQ(doc["escApe"].asString(), "caf\xC3\xA9 \xF0\x9F\x98\x80");
+    
+    const Jsonb escaped(R"({"k\u0065y": "caf\u00e9 \ud83d\ude00\n"})");
+    EXPECT_EQ(escaped["key"].asString(), "caf\xC3\xA9 \xF0\x9F\x98\x80\n");
+}
+
+TEST_F(JsonbTest, MissingValues) {
+    EXPECT_FALSE(doc.root().find("missing").has_value());
+    EXPECT_FALSE(doc["tags"].find(std::size_t{3}).has_value());
+    EXPECT_THROW((void)doc["missing"], std::out_of_range);
+    EXPECT_THROW((void)doc["tags"][7], std::out_of_range);
+}
+
+TEST_F(JsonbTest, TypeMismatch) {
+    EXPECT_THROW((void)doc["name"].asInt64(), std::runtime_error);
+    EXPECT_THROW((void)doc["score"].asInt64(), std::runtime_error);
+    EXPECT_THROW((void)doc["id"].asString(), std::runtime_error);
+    EXPECT_THROW((void)doc["tags"]["x"], std::runtime_error);
+    EXPECT_THROW((void)doc["id"].asBool(), std::runtime_error);
+}
+
+TEST_F(JsonbTest, Iteration) {
+    std::vector<std::string> tags;
+    doc["tags"].forEachElement([&](JsonView tag) { tags.push_back(tag.asString()); });
+    EXPECT_EQ(tags, (std::vector<std::string>{"admin", "ops", "a,b]c"}));
+    
+    std::vector<std::string> keys;
+    doc["nested"].forEachMember([&](const std::string& key, JsonView) { keys.push_back(key); });
+    EXPECT_EQ(keys, (std::vector<std::string>{"deep", "text"}));
+}
+
+TEST_F(JsonbTest, LongStringsAreSkipped) {
+    std::string longValue(1000, 'x');
+    longValue[500] = '\\';
+    longValue[501] = '"';
+    const Jsonb value("{\"skip\": \"" + longValue + "\", \"want\": 7}");
+    EXPECT_EQ(value["want"].asInt64(), 7);
+    EXPECT_EQ(value["skip"].asString().size(), 999u);
+}
+
+TEST_F(JsonbTest, MalformedInputIsReportedOnAccess) {
+    const Jsonb broken(R"({"a": 1, "b": "unterminated)");
+    EXPECT_EQ(broken["a"].asInt64(), 1);  // Scanning stops before the damage
+    EXPECT_THROW((void)broken["b"], std::runtime_error);
+    
+    const Jsonb noColon(R"({"a" 1})");
+    EXPECT_THROW((void)noColon["a"], std::runtime_error);
+}
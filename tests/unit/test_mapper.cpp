@@ -6,8 +6,13 @@
 #include <gtest/gtest.h>
 #include <pq/orm/Mapper.hpp>
 #include <pq/orm/Entity.hpp>
+#include <pq/orm/EntityCache.hpp>
+#include <pq/orm/IdentityMap.hpp>
+#include <array>
+#include <cstring>
 #include <string>
 #include <optional>
+#include <vector>
 
 using namespace pq;
 using namespace pq::orm;
@@ -68,6 +73,28 @@ class EntityMapperTest : public ::testing::Test {
 protected:
     void SetUp() override {}
     void TearDown() override {}
+    
+    // Build a text-format result in memory; nullptr cells are NULL
+    static core::QueryResult makeResult(const std::vector<std::string>& columns,
+                                        const std::vector<std::vector<const char*>>& rows) {
+        PGresult* res = PQmakeEmptyPGresult(nullptr, PGRES_TUPLES_OK);
+        std::vector<PGresAttDesc> attrs(columns.size());
+        for (size_t i = 0; i < columns.size(); ++i) {
+            attrs[i].name = const_cast<char*>(columns[i].c_str());
+            attrs[i].typlen = -1;
+            attrs[i].atttypmod = -1;
+        }
+        PQsetResultAttrs(res, static_cast<int>(attrs.size()), attrs.data());
+        for (size_t r = 0; r < rows.size(); ++r) {
+            for (size_t c = 0; c < rows[r].size(); ++c) {
+                const char* value = rows[r][c];
+                PQsetvalue(res, static_cast<int>(r), static_cast<int>(c),
+                           const_cast<char*>(value),
+                           value ? static_cast<int>(std::strlen(value)) : -1);
+            }
+        }
+        return core::QueryResult(core::makePgResult(res));
+    }
 };
 
 // ============================================================================
@@ -260,19 +287,19 @@ TEST_F(SqlBuilderTest, MetadataAccess) {
 TEST_F(SqlBuilderTest, NoPrimaryKeySelectById) {
     SqlBuilder<NoPkEntity> builder;
     
-    EXPECT_THROW(builder.selectByIdSql(), std::logic_error);
+    EXPECT_THROW((void)builder.selectByIdSql(), std::logic_error);
 }
 
 TEST_F(SqlBuilderTest, NoPrimaryKeyUpdate) {
     SqlBuilder<NoPkEntity> builder;
     
-    EXPECT_THROW(builder.updateSql(), std::logic_error);
+    EXPECT_THROW((void)builder.updateSql(), std::logic_error);
 }
 
 TEST_F(SqlBuilderTest, NoPrimaryKeyDelete) {
     SqlBuilder<NoPkEntity> builder;
     
-    EXPECT_THROW(builder.deleteSql(), std::logic_error);
+    EXPECT_THROW((void)builder.deleteSql(), std::logic_error);
 }
 
 TEST_F(SqlBuilderTest, NoPrimaryKeyValue) {
@@ -282,6 +309,249 @@ TEST_F(SqlBuilderTest, NoPrimaryKeyValue) {
     EXPECT_THROW(builder.primaryKeyValue(entity), std::logic_error);
 }
 
+TEST_F(SqlBuilderTest, StatementsAreBuiltOnce) {
+    SqlBuilder<MapperTestUser> first;
+    SqlBuilder<MapperTestUser> second;
+    
+    EXPECT_EQ(&first.insertSql(), &second.insertSql());
+    EXPECT_EQ(&first.updateSql(), &second.updateSql());
+    EXPECT_EQ(first.countSql(), "SELECT COUNT(*) FROM mapper_test_users");
+    EXPECT_EQ(first.existsByIdSql(), "SELECT 1 FROM mapper_test_users WHERE id = $1 LIMIT 1");
+}
+
+TEST_F(SqlBuilderTest, ParameterLayouts) {
+    SqlBuilder<MapperTestUser> builder;
+    
+    // Columns: id(0, auto), name(1), email(2), age(3)
+    EXPECT_EQ(builder.insertLayout().params, (std::vector<int>{1, 2, 3}));
+    EXPECT_EQ(builder.insertLayout(true).params, (std::vector<int>{0, 1, 2, 3}));
+    EXPECT_EQ(builder.updateLayout().params, (std::vector<int>{1, 2, 3, 0}));
+    
+    SqlBuilder<NoPkEntity> noPk;
+    EXPECT_THROW((void)noPk.updateLayout(), std::logic_error);
+    EXPECT_THROW((void)noPk.existsByIdSql(), std::logic_error);
+    EXPECT_EQ(noPk.insertLayout().params, (std::vector<int>{0}));
+}
+
+TEST_F(SqlBuilderTest, InsertBatchLayout) {
+    SqlBuilder<MapperTestUser> builder;
+    
+    const auto batch = builder.insertBatchLayout(3);
+    EXPECT_EQ(batch.sql,
+              "INSERT INTO mapper_test_users (name, email, age) VALUES "
+              "($1, $2, $3), ($4, $5, $6), ($7, $8, $9) RETURNING *");
+    EXPECT_EQ(batch.params, (std::vector<int>{1, 2, 3, 1, 2, 3, 1, 2, 3}));
+    EXPECT_EQ(batch.name, builder.insertBatchLayout(3).name);
+    EXPECT_NE(batch.name, builder.insertBatchLayout(2).name);
+    
+    // One row is the plain INSERT
+    EXPECT_EQ(builder.insertBatchLayout(1).sql, builder.insertSql());
+    
+    MapperTestUser user;
+    user.name = "Kim";
+    user.age = 30;
+    std::vector<std::string> params;
+    builder.appendInsertParams(user, params);
+    builder.appendInsertParams(user, params);
+    EXPECT_EQ(params, (std::vector<std::string>{"Kim", "", "30", "Kim", "", "30"}));
+}
+
+TEST_F(SqlBuilderTest, KeyArrayLayouts) {
+    SqlBuilder<MapperTestUser> builder;
+    
+    EXPECT_EQ(builder.deleteByIdsLayout().sql, "DELETE FROM mapper_test_users WHERE id = ANY($1)");
+    EXPECT_EQ(builder.deleteByIdsLayout().params, (std::vector<int>{0}));
+    EXPECT_EQ(builder.selectByIdsLayout().sql, "SELECT * FROM mapper_test_users WHERE id = ANY($1)");
+    EXPECT_NE(builder.selectByIdsLayout().name, builder.selectByIdLayout().name);
+    
+    SqlBuilder<NoPkEntity> noPk;
+    EXPECT_THROW((void)noPk.deleteByIdsLayout(), std::logic_error);
+    EXPECT_THROW((void)noPk.selectByIdsLayout(), std::logic_error);
+}
+
+TEST_F(SqlBuilderTest, PartialUpdateLayout) {
+    SqlBuilder<MapperTestUser> builder;
+    
+    // Columns: id(0), name(1), email(2), age(3)
+    const auto statusOnly = builder.updateLayout(std::vector<int>{3});
+    EXPECT_EQ(statusOnly.sql, "UPDATE mapper_test_users SET age = $1 WHERE id = $2 RETURNING *");
+    EXPECT_EQ(statusOnly.params, (std::vector<int>{3, 0}));
+    EXPECT_EQ(statusOnly.name, builder.updateLayout(std::vector<int>{3}).name);
+    EXPECT_NE(statusOnly.name, builder.updateLayout(std::vector<int>{1, 3}).name);
+    
+    // The primary key is never set; nothing else falls back to the full UPDATE
+    EXPECT_EQ(builder.updateLayout(std::vector<int>{0, 2}).params, (std::vector<int>{2, 0}));
+    EXPECT_EQ(builder.updateLayout(std::vector<int>{}).sql, builder.updateSql());
+    EXPECT_THROW((void)SqlBuilder<NoPkEntity>().updateLayout(std::vector<int>{0}), std::logic_error);
+}
+
+TEST_F(SqlBuilderTest, ColumnValuesSnapshot) {
+    SqlBuilder<MapperTestUser> builder;
+    MapperTestUser user;
+    user.id = 5;
+    user.name = "Lee";
+    user.age = 20;
+    
+    const auto before = builder.columnValues(user);
+    ASSERT_EQ(before.size(), 4u);
+    EXPECT_EQ(before[0], "5");
+    EXPECT_FALSE(before[2].has_value());
+    
+    user.age = 21;
+    const auto after = builder.columnValues(user);
+    EXPECT_EQ(before[1], after[1]);
+    EXPECT_NE(before[3], after[3]);
+}
+
+TEST_F(SqlBuilderTest, UpsertLayout) {
+    SqlBuilder<MapperTestUser> builder;
+    
+    // Conflict on a natural key: the auto-increment id is left to the database
+    const auto byName = builder.upsertLayout(2, {1});
+    EXPECT_EQ(byName.sql,
+              "INSERT INTO mapper_test_users (name, email, age) VALUES ($1, $2, $3), ($4, $5, $6)"
+              " ON CONFLICT (name) DO UPDATE SET email = EXCLUDED.email, age = EXCLUDED.age");
+    EXPECT_EQ(byName.params, (std::vector<int>{1, 2, 3, 1, 2, 3}));
+    
+    // Conflict on the auto-increment primary key: the id is written
+    EXPECT_TRUE(SqlBuilder<MapperTestUser>::includesAutoIncrement({0}));
+    EXPECT_EQ(builder.upsertLayout(1, {0}).sql,
+              "INSERT INTO mapper_test_users (id, name, email, age) VALUES ($1, $2, $3, $4)"
+              " ON CONFLICT (id) DO UPDATE SET name = EXCLUDED.name, email = EXCLUDED.email,"
+              " age = EXCLUDED.age");
+    
+    EXPECT_EQ(builder.upsertFromSql("stage", {1, 3}),
+              "INSERT INTO mapper_test_users (name, email, age) SELECT name, email, age FROM stage"
+              " ON CONFLICT (name, age) DO UPDATE SET email = EXCLUDED.email");
+    EXPECT_EQ(builder.upsertFromSql("stage", {1, 2, 3}),
+              "INSERT INTO mapper_test_users (name, email, age) SELECT name, email, age FROM stage"
+              " ON CONFLICT (name, email, age) DO NOTHING");
+    
+    // The last staged row of each conflict key wins
+    EXPECT_EQ(builder.upsertFromSql("stage", {1, 3}, "pq_ordinal"),
+              "INSERT INTO mapper_test_users (name, email, age) SELECT DISTINCT ON (name, age,"
+              " CASE WHEN name IS NULL OR age IS NULL THEN pq_ordinal END) name, email, age"
+              " FROM stage ORDER BY name, age,"
+              " CASE WHEN name IS NULL OR age IS NULL THEN pq_ordinal END, pq_ordinal DESC"
+              " ON CONFLICT (name, age) DO UPDATE SET email = EXCLUDED.email");
+}
+
+TEST_F(SqlBuilderTest, CopyFields) {
+    SqlBuilder<MapperTestUser> builder;
+    MapperTestUser user;
+    user.id = 7;
+    user.name = "Kim\tLee";
+    user.age = 30;
+    
+    std::string out;
+    builder.appendCopyFields(user, out);
+    EXPECT_EQ(out, "Kim\\tLee\t\\N\t30");
+    
+    // An empty string is not NULL; the auto-increment id is written on request
+    user.name.clear();
+    user.email = "";
+    out.clear();
+    builder.appendCopyFields(user, out, true);
+    EXPECT_EQ(out, "7\t\t\t30");
+}
+
+TEST_F(SqlBuilderTest, LastPerKey) {
+    // std::nullopt (a NULL in the key) never matches another row
+    const std::vector<std::optional<std::string>> keys = {
+        "a", "b", std::nullopt, "a", std::nullopt, "b", "c"};
+    EXPECT_EQ(pq::detail::lastPerKey(keys), (std::vector<std::size_t>{2, 3, 4, 5, 6}));
+    EXPECT_TRUE(pq::detail::lastPerKey({}).empty());
+}
+
+TEST_F(SqlBuilderTest, PageLayout) {
+    SqlBuilder<MapperTestUser> builder;
+    
+    // Columns: id(0), name(1), email(2), age(3)
+    EXPECT_EQ(builder.pageLayout({3, 0}, false).sql,
+              "SELECT * FROM mapper_test_users ORDER BY age, id LIMIT $1");
+    
+    const auto after = builder.pageLayout({3, 0}, true);
+    EXPECT_EQ(after.sql,
+              "SELECT * FROM mapper_test_users WHERE (age, id) > ($1, $2) "
+              "ORDER BY age, id LIMIT $3");
+    EXPECT_EQ(after.params, (std::vector<int>{3, 0}));
+    
+    EXPECT_EQ(builder.pageLayout({0}, true, SortOrder::Descending).sql,
+              "SELECT * FROM mapper_test_users WHERE (id) < ($1) ORDER BY id DESC LIMIT $2");
+    
+    MapperTestUser user;
+    user.id = 7;
+    user.age = 41;
+    EXPECT_EQ(builder.columnValue(user, 3), "41");
+    EXPECT_EQ(builder.columnValue(user, 0), "7");
+    EXPECT_FALSE(builder.columnValue(user, 2).has_value());  // NULL email
+}
+
+TEST_F(SqlBuilderTest, PageCursor) {
+    const std::vector<std::string> key = {"2024-01-02 03:04:05", "O'Brien, \"Jr\"", "42"};
+    const std::string token = pq::detail::encodePageCursor(key);
+    
+    EXPECT_EQ(token.find_first_not_of("0123456789abcdef"), std::string::npos);
+    EXPECT_EQ(pq::detail::decodePageCursor(token), key);
+    
+    EXPECT_FALSE(pq::detail::decodePageCursor("abc").has_value());
+    EXPECT_FALSE(pq::detail::decodePageCursor("zz").has_value());
+    EXPECT_FALSE(pq::detail::decodePageCursor("6869").has_value());  // "hi" is not array text
+}
+
+TEST_F(SqlBuilderTest, StatementNames) {
+    SqlBuilder<MapperTestUser> builder;
+    const std::string& insert = builder.insertLayout().name;
+    
+    // Same SQL always gets the same name, so any process can reuse it
+    EXPECT_EQ(insert, pq::detail::statementName("mapper_test_users", "insert", builder.insertSql()));
+    EXPECT_EQ(insert.rfind("pq_mapper_test_users_insert_", 0), 0u);
+    EXPECT_EQ(insert.size(), std::string("pq_mapper_test_users_insert_").size() + 8);
+    
+    EXPECT_NE(insert, builder.insertLayout(true).name);
+    EXPECT_NE(builder.selectByIdLayout().name, builder.deleteLayout().name);
+    
+    // Quoted or schema-qualified tables still yield a plain, bounded name
+    const std::string odd = pq::detail::statementName(
+        "\"Some Schema\".\"" + std::string(60, 'x') + "\"", "update", "UPDATE ...");
+    EXPECT_LT(odd.size(), 64u);
+    EXPECT_EQ(odd.rfind("pq__Some_Schema___xxx", 0), 0u);
+    EXPECT_EQ(odd.find_first_of("\". "), std::string::npos);
+}
+
+TEST_F(SqlBuilderTest, DistinctKeysKeepFirstOccurrence) {
+    const std::vector<std::string> keys = {"3", "1", "3", "2", "1"};
+    EXPECT_EQ(pq::detail::distinctKeys(keys), (std::vector<std::size_t>{0, 1, 3}));
+    EXPECT_TRUE(pq::detail::distinctKeys({}).empty());
+}
+
+TEST_F(SqlBuilderTest, MatchRowKeys) {
+    using pq::detail::matchRowKeys;
+    const std::vector<std::string> keys = {"a", "b", "c", "d"};
+    
+    // Rows come back in any order, some keys without a row
+    auto matches = matchRowKeys(keys, 1, 4, {"d", "b"});
+    ASSERT_EQ(matches.size(), 2u);
+    EXPECT_EQ(matches[0], 3u);
+    EXPECT_EQ(matches[1], 1u);
+    
+    // Only keys of the batch are matched
+    matches = matchRowKeys(keys, 2, 4, {"c"});
+    EXPECT_EQ(matches[0], 2u);
+    
+    // One row and one key left over: the server's spelling of that key
+    matches = matchRowKeys(keys, 0, 3, {"c", "B  ", "a"});
+    EXPECT_EQ(matches[0], 2u);
+    EXPECT_EQ(matches[1], 1u);
+    EXPECT_EQ(matches[2], 0u);
+    
+    // Two of them cannot be told apart
+    matches = matchRowKeys(keys, 0, 4, {"A", "c", "B"});
+    EXPECT_FALSE(matches[0].has_value());
+    EXPECT_EQ(matches[1], 2u);
+    EXPECT_FALSE(matches[2].has_value());
+}
+
 // ============================================================================
 // EntityMapper Tests
 // ============================================================================
@@ -317,6 +587,55 @@ TEST_F(EntityMapperTest, MetadataAccess) {
     EXPECT_EQ(pk->info.columnName, "id");
 }
 
+TEST_F(EntityMapperTest, MapAllInAnyColumnOrder) {
+    auto result = makeResult({"age", "email", "name", "id"},
+                             {{"30", "a@x.io", "Ann", "1"}, {"41", nullptr, "Bob", "2"}});
+    
+    const auto users = EntityMapper<MapperTestUser>().mapAll(result);
+    ASSERT_EQ(users.size(), 2u);
+    EXPECT_EQ(users[0].id, 1);
+    EXPECT_EQ(users[0].name, "Ann");
+    EXPECT_EQ(users[0].email, "a@x.io");
+    EXPECT_EQ(users[0].age, 30);
+    EXPECT_EQ(users[1].name, "Bob");
+    EXPECT_FALSE(users[1].email.has_value());
+}
+
+TEST_F(EntityMapperTest, PlanResolvesPositionsOnce) {
+    auto result = makeResult({"age", "email", "name", "id"},
+                             {{"30", "a@x.io", "Ann", "1"}, {"41", nullptr, "Bob", "2"}});
+    
+    EntityMapper<MapperTestUser> mapper;
+    const auto plan = mapper.plan(result);
+    EXPECT_EQ(plan.index, (std::array<int, 4>{3, 2, 1, 0}));
+    EXPECT_EQ(plan.format[0], Format::Text);
+    
+    const auto bob = mapper.mapRow(result[1], plan);
+    EXPECT_EQ(bob.id, 2);
+    EXPECT_EQ(bob.age, 41);
+    
+    auto missing = makeResult({"id", "name"}, {});
+    EXPECT_THROW((void)mapper.plan(missing), MappingException);
+    EXPECT_TRUE(mapper.mapAll(missing).empty());  // Nothing to map, nothing to check
+}
+
+TEST_F(EntityMapperTest, MapRowErrors) {
+    EntityMapper<MapperTestUser> mapper;
+    
+    auto missing = makeResult({"id", "name", "email"}, {{"1", "Ann", nullptr}});
+    EXPECT_THROW((void)mapper.mapOne(missing), MappingException);
+    
+    auto nullName = makeResult({"id", "name", "email", "age"}, {{"1", nullptr, nullptr, "3"}});
+    EXPECT_THROW((void)mapper.mapOne(nullName), MappingException);
+    
+    auto extra = makeResult({"id", "name", "email", "age", "extra"}, {{"1", "A", nullptr, "3", "x"}});
+    EXPECT_THROW((void)mapper.mapOne(extra), MappingException);
+    
+    MapperConfig lenient;
+    lenient.ignoreExtraColumns = true;
+    EXPECT_EQ(EntityMapper<MapperTestUser>(lenient).mapOne(extra)->age, 3);
+}
+
 // ============================================================================
 // MappingException Tests
 // ============================================================================
@@ -403,3 +722,234 @@ TEST_F(SqlBuilderTest, ProductInsertParamsNullDescription) {
     EXPECT_EQ(params[2], "f");  // bool false
     EXPECT_TRUE(params[3].empty());  // NULL description
 }
+
+TEST_F(SqlBuilderTest, ChangeSnapshotsDroppedAfterRollback) {
+    pq::detail::ChangeSnapshots snapshots(3);
+    snapshots.put("1", {std::string("1"), std::string("A")}, 3);
+    ASSERT_NE(snapshots.find("1", 3), nullptr);
+    EXPECT_EQ((*snapshots.find("1", 3))[1], "A");
+    
+    // Updated to B inside a transaction that is then rolled back
+    snapshots.put("1", {std::string("1"), std::string("B")}, 3);
+    EXPECT_EQ(snapshots.find("1", 4), nullptr);
+    
+    // Snapshots taken after the rollback are used again
+    snapshots.put("1", {std::string("1"), std::string("A")}, 4);
+    EXPECT_NE(snapshots.find("1", 4), nullptr);
+    snapshots.erase("1");
+    EXPECT_EQ(snapshots.find("1", 4), nullptr);
+}
+
+// ============================================================================
+// IdentityMap Tests
+// ============================================================================
+
+class IdentityMapTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+    void TearDown() override {}
+};
+
+TEST_F(IdentityMapTest, KeyedByTypeAndPrimaryKey) {
+    pq::core::Connection conn;
+    IdentityMap identities(conn);
+    
+    MapperTestUser user;
+    user.id = 1;
+    user.name = "Kim";
+    MapperTestProduct product;
+    product.productId = 1;
+    product.productName = "Pen";
+    
+    identities.put(std::string("1"), user);
+    identities.put(std::string("1"), product);
+    EXPECT_EQ(identities.size(), 2u);
+    
+    const MapperTestUser* foundUser = identities.find<MapperTestUser>("1");
+    ASSERT_NE(foundUser, nullptr);
+    EXPECT_EQ(foundUser->name, "Kim");
+    EXPECT_EQ(identities.find<MapperTestProduct>("1")->productName, "Pen");
+    EXPECT_EQ(identities.find<MapperTestUser>("2"), nullptr);
+    
+    // Later writes replace the recorded state
+    user.name = "Lee";
+    identities.put(std::string("1"), user);
+    EXPECT_EQ(identities.find<MapperTestUser>("1")->name, "Lee");
+}
+
+TEST_F(IdentityMapTest, EraseEvictAndClear) {
+    pq::core::Connection conn;
+    IdentityMap identities(conn);
+    
+    MapperTestUser user;
+    for (int id = 1; id <= 3; ++id) {
+        user.id = id;
+        identities.put(std::to_string(id), user);
+    }
+    MapperTestProduct product;
+    identities.put(std::string("1"), product);
+    
+    identities.erase<MapperTestUser>("2");
+    EXPECT_EQ(identities.find<MapperTestUser>("2"), nullptr);
+    EXPECT_EQ(identities.size(), 3u);
+    
+    identities.evict<MapperTestUser>();
+    EXPECT_EQ(identities.find<MapperTestUser>("1"), nullptr);
+    EXPECT_NE(identities.find<MapperTestProduct>("1"), nullptr);
+    
+    identities.clear();
+    EXPECT_EQ(identities.size(), 0u);
+    EXPECT_EQ(&identities.connection(), &conn);
+}
+
+// ============================================================================
+// EntityCache Tests
+// ============================================================================
+
+class EntityCacheTest : public ::testing::Test {
+protected:
+    static MapperTestUser user(int id, const std::string& name) {
+        MapperTestUser u;
+        u.id = id;
+        u.name = name;
+        return u;
+    }
+};
+
+TEST_F(EntityCacheTest, HitsAndMisses) {
+    EntityCache cache;
+    cache.put("users", "1", user(1, "Kim"), 100);
+    
+    auto hit = cache.get<MapperTestUser>("users", "1");
+    ASSERT_NE(hit, nullptr);
+    EXPECT_EQ(hit->name, "Kim");
+    EXPECT_EQ(cache.get<MapperTestUser>("users", "2"), nullptr);
+    EXPECT_EQ(cache.get<MapperTestUser>("orders", "1"), nullptr);
+    // Same key under another entity type is a miss, not a bad cast
+    EXPECT_EQ(cache.get<MapperTestProduct>("users", "1"), nullptr);
+    
+    const auto stats = cache.stats();
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(stats.misses, 3u);
+    EXPECT_EQ(stats.entries, 1u);
+    EXPECT_DOUBLE_EQ(stats.hitRatio(), 0.25);
+    
+    cache.resetStats();
+    EXPECT_EQ(cache.stats().hits, 0u);
+    EXPECT_EQ(cache.stats().entries, 1u);
+}
+
+TEST_F(EntityCacheTest, EvictsLeastRecentlyUsedWithinBudget) {
+    EntityCacheConfig config;
+    config.shards = 1;
+    config.maxBytes = 2500;  // Two entries with their key and bookkeeping
+    EntityCache cache(config);
+    
+    cache.put("users", "1", user(1, "a"), 800);
+    cache.put("users", "2", user(2, "b"), 800);
+    ASSERT_NE(cache.get<MapperTestUser>("users", "1"), nullptr);  // 2 is now least recent
+    cache.put("users", "3", user(3, "c"), 800);
+    
+    EXPECT_NE(cache.get<MapperTestUser>("users", "1"), nullptr);
+    EXPECT_EQ(cache.get<MapperTestUser>("users", "2"), nullptr);
+    EXPECT_NE(cache.get<MapperTestUser>("users", "3"), nullptr);
+    EXPECT_EQ(cache.stats().evictions, 1u);
+    EXPECT_LE(cache.stats().bytes, config.maxBytes);
+    
+    // Larger than the whole shard: not stored
+    cache.put("users", "4", user(4, "d"), 5000);
+    EXPECT_EQ(cache.get<MapperTestUser>("users", "4"), nullptr);
+}
+
+TEST_F(EntityCacheTest, ExpiresAfterTtl) {
+    EntityCacheConfig config;
+    config.ttl = std::chrono::milliseconds(0);
+    EntityCache cache(config);
+    cache.setTtl("users", std::chrono::hours(1));
+    
+    cache.put("users", "1", user(1, "Kim"), 100);
+    cache.put("orders", "1", user(1, "Kim"), 100);
+    
+    EXPECT_NE(cache.get<MapperTestUser>("users", "1"), nullptr);
+    EXPECT_EQ(cache.get<MapperTestUser>("orders", "1"), nullptr);
+    EXPECT_EQ(cache.stats().expirations, 1u);
+}
+
+TEST_F(EntityCacheTest, Invalidation) {
+    EntityCache cache;
+    cache.put("users", "1", user(1, "a"), 100);
+    cache.put("users", "2", user(2, "b"), 100);
+    cache.put("users_archive", "1", user(1, "a"), 100);
+    
+    cache.invalidate("users", "1");
+    EXPECT_EQ(cache.get<MapperTestUser>("users", "1"), nullptr);
+    
+    cache.invalidateTable("users");
+    EXPECT_EQ(cache.get<MapperTestUser>("users", "2"), nullptr);
+    EXPECT_NE(cache.get<MapperTestUser>("users_archive", "1"), nullptr);
+    EXPECT_EQ(cache.stats().invalidations, 2u);
+    
+    cache.clear();
+    EXPECT_EQ(cache.stats().entries, 0u);
+    EXPECT_EQ(cache.stats().bytes, 0u);
+}
+
+TEST_F(EntityCacheTest, StaleFillIsDropped) {
+    EntityCache cache;
+    
+    // A reader stamps before its query; a write is invalidated meanwhile
+    const uint64_t stamp = cache.stamp("users", "1");
+    cache.invalidate("users", "1");
+    cache.put("users", "1", user(1, "old"), 100, stamp);
+    EXPECT_EQ(cache.get<MapperTestUser>("users", "1"), nullptr);
+    
+    cache.put("users", "1", user(1, "new"), 100, cache.stamp("users", "1"));
+    EXPECT_EQ(cache.get<MapperTestUser>("users", "1")->name, "new");
+}
+
+TEST_F(EntityCacheTest, TransactionalWriteInvalidatedAgainAfterCommit) {
+    EntityCache cache;
+    pq::core::Connection conn;
+    
+    // The write, inside a transaction: its invalidation does not stop a reader
+    // on another connection that stamps afterwards and still sees the old row
+    cache.invalidate("users", "1");
+    const uint64_t stamp = cache.stamp("users", "1");
+    cache.put("users", "1", user(1, "old"), 100, stamp);
+    ASSERT_NE(cache.get<MapperTestUser>("users", "1"), nullptr);
+    
+    // COMMIT runs the queued invalidation (here at once: no transaction is open)
+    conn.afterCommit([&cache] { cache.invalidate("users", "1"); });
+    EXPECT_EQ(cache.get<MapperTestUser>("users", "1"), nullptr);
+    
+    // and a fill stamped before the commit is dropped as well
+    cache.put("users", "1", user(1, "old"), 100, stamp);
+    EXPECT_EQ(cache.get<MapperTestUser>("users", "1"), nullptr);
+}
+
+TEST_F(EntityCacheTest, NotificationPayloads) {
+    EntityCache cache;
+    cache.put("users", "1", user(1, "a"), 100);
+    cache.put("users", "2", user(2, "b"), 100);
+    cache.put("orders", "7", user(7, "c"), 100);
+    
+    cache.invalidate(pq::core::Notification{EntityCache::defaultChannel, "users:1", 42});
+    EXPECT_EQ(cache.get<MapperTestUser>("users", "1"), nullptr);
+    EXPECT_NE(cache.get<MapperTestUser>("users", "2"), nullptr);
+    
+    cache.invalidate(pq::core::Notification{EntityCache::defaultChannel, "users", 42});
+    EXPECT_EQ(cache.get<MapperTestUser>("users", "2"), nullptr);
+    EXPECT_NE(cache.get<MapperTestUser>("orders", "7"), nullptr);
+}
+
+TEST_F(EntityCacheTest, NotifyTriggerSql) {
+    const std::string sql = EntityCache::notifyTriggerSql<MapperTestUser>();
+    
+    EXPECT_NE(sql.find("CREATE OR REPLACE FUNCTION pq_mapper_test_users_notify_"), std::string::npos);
+    EXPECT_NE(sql.find("pg_notify('pq_entity_cache', 'mapper_test_users' || ':' || "
+                       "format('%s', OLD.id))"),
+              std::string::npos);
+    EXPECT_NE(sql.find("AFTER UPDATE OR DELETE ON mapper_test_users FOR EACH ROW"), std::string::npos);
+    EXPECT_NE(sql.find("AFTER TRUNCATE ON mapper_test_users FOR EACH STATEMENT"), std::string::npos);
+    EXPECT_THROW((void)EntityCache::notifyTriggerSql<NoPkEntity>(), std::logic_error);
+}
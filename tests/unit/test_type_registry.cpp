@@ -0,0 +1,95 @@
+/**
+ * @file test_type_registry.cpp
+ * @brief Unit tests for the runtime type OID registry
+ */
+
+#include <gtest/gtest.h>
+#include <pq/core/TypeRegistry.hpp>
+#include <pq/core/Enum.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace catalog {
+
+enum class Mood { Sad, Ok, Happy };
+
+} // namespace catalog
+
+PQ_ENUM(catalog::Mood, "mood",
+    PQ_ENUM_VALUE(catalog::Mood::Sad, "sad"),
+    PQ_ENUM_VALUE(catalog::Mood::Ok, "ok"),
+    PQ_ENUM_VALUE(catalog::Mood::Happy, "happy"))
+
+using namespace pq;
+using namespace pq::core;
+
+class TypeRegistryTest : public ::testing::Test {
+protected:
+    TypeRegistry registry;
+    
+    void SetUp() override {
+        registry.add(PgTypeInfo{"mood", 16390, 16389, 'e'});
+    }
+};
+
+TEST_F(TypeRegistryTest, FindByName) {
+    const auto mood = registry.find("mood");
+    ASSERT_TRUE(mood.has_value());
+    EXPECT_EQ(mood->oid, 16390u);
+    EXPECT_EQ(mood->arrayOid, 16389u);
+    EXPECT_EQ(mood->kind, 'e');
+    
+    EXPECT_FALSE(registry.find("color").has_value());
+}
+
+TEST_F(TypeRegistryTest, ArrayTypeIsIndexed) {
+    const auto moods = registry.find("mood[]");
+    ASSERT_TRUE(moods.has_value());
+    EXPECT_EQ(moods->oid, 16389u);
+    EXPECT_EQ(moods->arrayOid, 0u);
+    EXPECT_EQ(registry.size(), 2u);
+}
+
+TEST_F(TypeRegistryTest, FindByOid) {
+    EXPECT_EQ(registry.findByOid(16390)->name, "mood");
+    EXPECT_EQ(registry.findByOid(16389)->name, "mood[]");
+    EXPECT_FALSE(registry.findByOid(oid::INT4).has_value());
+}
+
+TEST_F(TypeRegistryTest, OidOfTraits) {
+    EXPECT_EQ(registry.oidOf<catalog::Mood>(), 16390u);
+    EXPECT_EQ(registry.oidOf<int32_t>(), oid::INT4);  // Fixed OIDs need no entry
+    
+    registry.clear();
+    EXPECT_EQ(registry.oidOf<catalog::Mood>(), 0u);
+    EXPECT_EQ(registry.size(), 0u);
+}
+
+TEST_F(TypeRegistryTest, CachedNamesNeedNoQuery) {
+    Connection conn;  // Not connected: any query would fail
+    EXPECT_TRUE(registry.load(conn, {"mood", "mood[]"}).hasValue());
+    EXPECT_TRUE(registry.loadTypes<catalog::Mood>(conn).hasValue());
+    EXPECT_EQ(registry.resolve(conn, "mood")->oid, 16390u);
+    
+    EXPECT_FALSE(registry.load(conn, {"color"}).hasValue());
+    EXPECT_FALSE(registry.resolve(conn, "color").hasValue());
+}
+
+TEST_F(TypeRegistryTest, ConcurrentLookups) {
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([this, i] {
+            for (int n = 0; n < 1000; ++n) {
+                EXPECT_EQ(registry.oidOf<catalog::Mood>(), 16390u);
+                if (n % 100 == 0) {
+                    registry.add(PgTypeInfo{"t" + std::to_string(i), 20000u + i, 0, 'c'});
+                }
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    EXPECT_EQ(registry.size(), 6u);
+}
@@ -5,6 +5,8 @@
 
 #include <gtest/gtest.h>
 #include <pq/core/Types.hpp>
+#include <cmath>
+#include <limits>
 #include <optional>
 #include <string>
 
@@ -277,6 +279,86 @@ TEST_F(TypeTraitsTest, ParamConverterDouble) {
     EXPECT_NE(std::string(conv.ptr).find("3.14"), std::string::npos);
 }
 
+TEST_F(TypeTraitsTest, FormatToWritesIntoCallerBuffer) {
+    char buf[32];
+    std::size_t n = PgTypeTraits<int64_t>::formatTo(INT64_MIN, buf, sizeof(buf));
+    EXPECT_EQ(std::string(buf, n), "-9223372036854775808");
+    EXPECT_EQ(n, PgTypeTraits<int64_t>::maxTextLength);
+    
+    n = PgTypeTraits<int32_t>::formatTo(INT32_MIN, buf, sizeof(buf));
+    EXPECT_EQ(n, PgTypeTraits<int32_t>::maxTextLength);
+    n = PgTypeTraits<int16_t>::formatTo(INT16_MIN, buf, sizeof(buf));
+    EXPECT_EQ(n, PgTypeTraits<int16_t>::maxTextLength);
+    
+    n = PgTypeTraits<bool>::formatTo(true, buf, sizeof(buf));
+    EXPECT_EQ(std::string(buf, n), "t");
+    
+    // Too small a buffer writes nothing usable
+    EXPECT_EQ(PgTypeTraits<int32_t>::formatTo(12345, buf, 3), 0u);
+    
+    EXPECT_TRUE(hasFormatToV<int32_t>);
+    EXPECT_TRUE(hasFormatToV<double>);
+    EXPECT_FALSE(hasFormatToV<std::string>);
+}
+
+TEST_F(TypeTraitsTest, ParamConverterFormatsInline) {
+    ParamConverter<int64_t> conv(INT64_MAX);
+    EXPECT_STREQ(conv.ptr, "9223372036854775807");
+    EXPECT_TRUE(conv.value.empty());  // No heap string for numbers
+    
+    ParamConverter<std::optional<int16_t>> optConv(std::optional<int16_t>(-5));
+    EXPECT_STREQ(optConv.ptr, "-5");
+}
+
+TEST_F(TypeTraitsTest, FloatShortestRoundTrip) {
+    EXPECT_EQ(PgTypeTraits<double>::toString(1e-9), "1e-09");
+    EXPECT_EQ(PgTypeTraits<double>::toString(0.1), "0.1");
+    EXPECT_EQ(PgTypeTraits<double>::toString(100.0), "100");
+    EXPECT_EQ(PgTypeTraits<float>::toString(0.1f), "0.1");
+    EXPECT_EQ(PgTypeTraits<float>::toString(3.14f), "3.14");
+    
+    const double doubles[] = {
+        1e-9, 0.1 + 0.2, 1.0 / 3.0, 6.02214076e23, -2.2250738585072014e-308,
+        std::numeric_limits<double>::max(), std::numeric_limits<double>::denorm_min()
+    };
+    for (double value : doubles) {
+        const std::string text = PgTypeTraits<double>::toString(value);
+        EXPECT_LE(text.size(), PgTypeTraits<double>::maxTextLength);
+        EXPECT_EQ(PgTypeTraits<double>::fromString(text.c_str()), value) << text;
+    }
+    
+    const float floats[] = {
+        1e-9f, 16777217.0f, -1.17549435e-38f, std::numeric_limits<float>::max(),
+        std::numeric_limits<float>::denorm_min()
+    };
+    for (float value : floats) {
+        const std::string text = PgTypeTraits<float>::toString(value);
+        EXPECT_LE(text.size(), PgTypeTraits<float>::maxTextLength);
+        EXPECT_EQ(PgTypeTraits<float>::fromString(text.c_str()), value) << text;
+    }
+}
+
+TEST_F(TypeTraitsTest, FloatSpecialValues) {
+    EXPECT_TRUE(std::isinf(PgTypeTraits<double>::fromString("Infinity")));
+    EXPECT_LT(PgTypeTraits<double>::fromString("-Infinity"), 0.0);
+    EXPECT_TRUE(std::isnan(PgTypeTraits<double>::fromString("NaN")));
+    EXPECT_EQ(PgTypeTraits<double>::fromString("+1.5"), 1.5);
+    
+    const std::string inf = PgTypeTraits<double>::toString(
+        std::numeric_limits<double>::infinity());
+    EXPECT_TRUE(std::isinf(PgTypeTraits<double>::fromString(inf.c_str())));
+    
+    EXPECT_THROW((void)PgTypeTraits<double>::fromString("abc"), std::invalid_argument);
+    EXPECT_THROW((void)PgTypeTraits<double>::fromString("1.5x"), std::invalid_argument);
+    EXPECT_THROW((void)PgTypeTraits<float>::fromString("1e60"), std::out_of_range);
+    
+    // Subnormals parse; only overflow and underflow to zero are out of range
+    EXPECT_EQ(PgTypeTraits<double>::fromString("5e-324"), std::numeric_limits<double>::denorm_min());
+    EXPECT_EQ(PgTypeTraits<float>::fromString("1e-45"), std::numeric_limits<float>::denorm_min());
+    EXPECT_THROW((void)PgTypeTraits<double>::fromString("1e400"), std::out_of_range);
+    EXPECT_THROW((void)PgTypeTraits<double>::fromString("1e-400"), std::out_of_range);
+}
+
 TEST_F(TypeTraitsTest, OptionalInnerType) {
     EXPECT_TRUE((std::is_same_v<OptionalInnerT<int>, int>));
     EXPECT_TRUE((std::is_same_v<OptionalInnerT<std::optional<int>>, int>));
@@ -298,3 +380,27 @@ TEST_F(TypeTraitsTest, OidConstants) {
     EXPECT_EQ(oid::UUID, 2950u);
     EXPECT_EQ(oid::JSONB, 3802u);
 }
+
+TEST_F(TypeTraitsTest, BinaryDecoders) {
+    const char int4[] = {0x00, 0x00, 0x01, 0x2C};
+    EXPECT_EQ(PgTypeTraits<int32_t>::fromBinary(int4, 4), 300);
+    
+    const char int8[] = {'\xFF', '\xFF', '\xFF', '\xFF', '\xFF', '\xFF', '\xFF', '\xFE'};
+    EXPECT_EQ(PgTypeTraits<int64_t>::fromBinary(int8, 8), -2);
+    
+    const char float8[] = {0x40, 0x09, 0x21, (char)0xFB, 0x54, 0x44, 0x2D, 0x18};
+    EXPECT_DOUBLE_EQ(PgTypeTraits<double>::fromBinary(float8, 8), 3.141592653589793);
+    
+    const char boolTrue[] = {0x01};
+    EXPECT_TRUE(PgTypeTraits<bool>::fromBinary(boolTrue, 1));
+    
+    EXPECT_EQ(PgTypeTraits<std::string>::fromBinary("abc", 3), "abc");
+    
+    EXPECT_THROW((void)PgTypeTraits<int32_t>::fromBinary(int4, 2), std::runtime_error);
+}
+
+TEST_F(TypeTraitsTest, DecodeValueDispatchesOnFormat) {
+    const char int2[] = {0x00, 0x2A};
+    EXPECT_EQ(decodeValue<int16_t>(int2, 2, Format::Binary), 42);
+    EXPECT_EQ(decodeValue<int16_t>("42", 2, Format::Text), 42);
+}
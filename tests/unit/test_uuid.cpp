@@ -0,0 +1,121 @@
+/**
+ * @file test_uuid.cpp
+ * @brief Unit tests for the Uuid type and hex codec
+ */
+
+#include <gtest/gtest.h>
+#include <pq/core/Uuid.hpp>
+#include <pq/core/Hex.hpp>
+#include <string>
+#include <type_traits>
+#include <unordered_set>
+#include <vector>
+
+using namespace pq;
+
+class UuidTest : public ::testing::Test {
+protected:
+    static constexpr const char* kCanonical = "a0eebc99-9c0b-4ef8-bb6d-6bb9bd380a11";
+};
+
+TEST_F(UuidTest, TypeTraits) {
+    EXPECT_EQ(PgTypeTraits<Uuid>::pgOid, oid::UUID);
+    EXPECT_STREQ(PgTypeTraits<Uuid>::pgTypeName, "uuid");
+    EXPECT_FALSE(PgTypeTraits<Uuid>::isNullable);
+    EXPECT_TRUE(hasBinaryDecoderV<Uuid>);
+}
+
+TEST_F(UuidTest, InlineStorage) {
+    EXPECT_EQ(sizeof(Uuid), 16u);
+    EXPECT_TRUE(std::is_trivially_copyable_v<Uuid>);
+    EXPECT_TRUE(Uuid().isNil());
+}
+
+TEST_F(UuidTest, ParseAndFormatRoundTrip) {
+    Uuid id = Uuid::fromString(kCanonical);
+    EXPECT_EQ(id.bytes()[0], 0xA0);
+    EXPECT_EQ(id.bytes()[15], 0x11);
+    EXPECT_EQ(id.toString(), kCanonical);
+    EXPECT_FALSE(id.isNil());
+}
+
+TEST_F(UuidTest, ParseAcceptsPostgresInputForms) {
+    const Uuid expected = Uuid::fromString(kCanonical);
+    EXPECT_EQ(Uuid::fromString("A0EEBC99-9C0B-4EF8-BB6D-6BB9BD380A11"), expected);
+    EXPECT_EQ(Uuid::fromString("{a0eebc99-9c0b-4ef8-bb6d-6bb9bd380a11}"), expected);
+    EXPECT_EQ(Uuid::fromString("a0eebc999c0b4ef8bb6d6bb9bd380a11"), expected);
+    EXPECT_EQ(Uuid::fromString("a0ee-bc99-9c0b-4ef8-bb6d-6bb9-bd38-0a11"), expected);
+    EXPECT_EQ(Uuid::fromString("{a0eebc999c0b4ef8bb6d6bb9bd380a11}"), expected);
+}
+
+TEST_F(UuidTest, ParseRejectsMalformedInput) {
+    EXPECT_THROW((void)Uuid::fromString(""), std::invalid_argument);
+    EXPECT_THROW((void)Uuid::fromString("a0eebc99-9c0b-4ef8-bb6d-6bb9bd380a1"), std::invalid_argument);
+    EXPECT_THROW((void)Uuid::fromString("g0eebc99-9c0b-4ef8-bb6d-6bb9bd380a11"), std::invalid_argument);
+    EXPECT_THROW((void)Uuid::fromString("a0eebc99-9c0b-4ef8-bb6d-6bb9bd380a11-"), std::invalid_argument);
+    EXPECT_THROW((void)Uuid::fromString("a0eeb-c99-9c0b-4ef8-bb6d-6bb9bd380a11"), std::invalid_argument);
+    EXPECT_THROW((void)Uuid::fromString("a0eebc99--9c0b4ef8-bb6d-6bb9bd380a11"), std::invalid_argument);
+}
+
+TEST_F(UuidTest, BinaryCodec) {
+    const Uuid id = Uuid::fromString(kCanonical);
+    const std::string wire = PgTypeTraits<Uuid>::toBinary(id);
+    ASSERT_EQ(wire.size(), 16u);
+    EXPECT_EQ(static_cast<unsigned char>(wire[0]), 0xA0);
+    
+    EXPECT_EQ(decodeValue<Uuid>(wire.data(), 16, Format::Binary), id);
+    EXPECT_EQ(decodeValue<Uuid>(kCanonical, 36, Format::Text), id);
+    EXPECT_THROW((void)PgTypeTraits<Uuid>::fromBinary(wire.data(), 15), std::runtime_error);
+}
+
+TEST_F(UuidTest, HashAndOrdering) {
+    const Uuid a = Uuid::fromString("00000000-0000-0000-0000-000000000001");
+    const Uuid b = Uuid::fromString("00000000-0000-0000-0000-000000000002");
+    const Uuid c = Uuid::fromString("10000000-0000-0000-0000-000000000000");
+    
+    EXPECT_LT(a, b);
+    EXPECT_LT(b, c);
+    EXPECT_NE(std::hash<Uuid>{}(a), std::hash<Uuid>{}(b));
+    
+    std::unordered_set<Uuid> set{a, b, c, a};
+    EXPECT_EQ(set.size(), 3u);
+    EXPECT_EQ(set.count(Uuid::fromString("00000000-0000-0000-0000-000000000002")), 1u);
+}
+
+TEST(HexTest, RoundTripAllByteValues) {
+    std::vector<unsigned char> bytes(256 + 7);
+    for (std::size_t i = 0; i < bytes.size(); ++i) {
+        bytes[i] = static_cast<unsigned char>(i * 31);
+    }
+    
+    std::string hex(bytes.size() * 2, '\0');
+    detail::hexEncode(bytes.data(), bytes.size(), hex.data());
+    EXPECT_EQ(hex.substr(0, 6), "001f3e");
+    
+    std::vector<unsigned char> decoded(bytes.size());
+    ASSERT_TRUE(detail::hexDecode(hex.data(), decoded.size(), decoded.data()));
+    EXPECT_EQ(decoded, bytes);
+}
+
+TEST(HexTest, DecodeIsCaseInsensitive) {
+    unsigned char out[16];
+    ASSERT_TRUE(detail::hexDecode("DEADbeefDEADbeefDEADbeefDEADbeef", 16, out));
+    EXPECT_EQ(out[0], 0xDE);
+    EXPECT_EQ(out[3], 0xEF);
+    EXPECT_EQ(out[15], 0xEF);
+}
+
+TEST(HexTest, DecodeRejectsNonHexInBothPaths) {
+    std::string hex(64, 'a');
+    unsigned char out[32];
+    ASSERT_TRUE(detail::hexDecode(hex.data(), 32, out));
+    
+    for (char bad : {'g', 'G', '/', ':', '@', '`', ' ', '\x80', '\xB5', '\xE1'}) {
+        for (std::size_t pos : {std::size_t{0}, std::size_t{17}, std::size_t{63}}) {
+            std::string broken = hex;
+            broken[pos] = bad;
+            EXPECT_FALSE(detail::hexDecode(broken.data(), 32, out))
+                << "char " << static_cast<int>(bad) << " at " << pos;
+        }
+    }
+}